@@ -29,9 +29,10 @@
  * 		happens reasonably slowly (up to 750mS)
  * 		can be triggered to execute in parallel for all "equivalent" devices on a bus
  *	To optimise operation, this driver is based on the following decisions/constraints:
- *		Tsns is specified at device type (psEWP level) for ALL /ow/ds18x20 devices and will
- *		always trigger a sample+convert operation for ALL devices on a bus at same time.
- *		EWP Tsns kept at a value equal to lowest of all EWS Tsns values
+ *		Tsns is specified per sensor (EWS level) and kept in ds18x20_t.Tper, each sensor has its
+ *		own deadline (Tdue). EWP Tsns is the scheduler tick, the GCD of all sensor periods.
+ *		Every tick the sensors due (deadline within half a tick) are marked, a single broadcast
+ *		sample+convert is triggered on each bus with 1+ due sensor and ONLY due sensors are read.
  *		Maintain a minimum Tsns of 1000mSec to be bigger than the ~750mS standard.
  * 	Test parasitic power
  * 	Test & benchmark overdrive speed
@@ -39,8 +40,8 @@
  *
  * 	Optimisation:
  * 	If more than 1 DS248x is present Tsns will trigger convert on 1st bus of each DS248x device (parallelism)
- * 	Each device will start a timer to call handler to read and convert all DS18X20's on the bus
- * 	Handler will loop and read each sensor on the current bus.
+ * 	Each device will start a timer, on expiry the read task is handed the bus to read and convert
+ * 	all DS18X20's on it. The task (not the timer daemon) loops and reads each sensor on the bus.
  * 	If more than 1 bus on the device (DS2482-800) handler will release current bus.
  * 	The next bus will be selected and convert trigger triggered.
  * 	Logic will ONLY trigger convert on bus if 1 or more ds18x20 were discovered at boot.
@@ -53,24 +54,25 @@
 #define	ds18x20DELAY_SP_COPY		11		// mSec
 #define	ds18x20T_SNS_MIN			1000
 #define	ds18x20T_SNS_NORM			60000
-
-// ################################## DS18X20 1-Wire Commands ######################################
-
-#define	DS18X20_CONVERT				0x44
-#define	DS18X20_COPY_SP				0x48
-#define	DS18X20_WRITE_SP			0x4E
-#define	DS18X20_READ_PSU			0xB4
-#define	DS18X20_RECALL_EE			0xB8
-#define	DS18X20_READ_SP				0xBE
+#define	ds18x20DEADBAND_DEF			1		// raw units, publish on ANY change of the raw value
+#define	ds18x20T_SILENT_MAX			300		// Sec, publish at least this often even if unchanged
+#define	ds18x20DEV(psOW)			(((psOW)->Type << 2) | (psOW)->DevNum)	// DevNum is per backend type
+#define	ds18x20READ_QLEN			16		// 1 chain per ds18x20DEV() in flight, see ds18x20Busy
 
 // ################################ Forward function declaration ###################################
 
+static void ds18x20ReadTask(void * pvPara);
+
 // ######################################### Constants #############################################
 
 // ###################################### Local variables ##########################################
 
 ds18x20_t *	psaDS18X20 = NULL;
 u8_t Fam10Count = 0, Fam28Count = 0, Fam10_28Count = 0;
+static SemaphoreHandle_t * pCacheMux = NULL;			// per logical bus, serialises refresh passes
+static ds18x20cache_t sCache;
+static u16_t ds18x20Busy = 0;							// ds18x20DEV() bit set while its read chain runs
+static QueueHandle_t ReadQ = NULL;						// step 3 chains, index of 1st sensor on the bus
 
 // #################################### Local ONLY functions #######################################
 
@@ -95,12 +97,12 @@ bool ds18x20CheckPower(ds18x20_t * psDS18X20) {
  * @return
  * @note	Timing is as follows
  *	OWReset		196/1348uS
- *	OWCommand	1447/7740uS
+ *	OWCommand	1447/7740uS (MATCH ROM) or 163/860uS (SKIP ROM, single device on bus)
  *	OWReadBlock		163/860 per byte, 326/1720 for temperature, 815/4300 for all.
- *	Total Time	1969/10808 for temperature
+ *	Total Time	1969/10808 (MATCH ROM) or 685/3928 (SKIP ROM) for temperature
  */
 int	ds18x20ReadSP(ds18x20_t * psDS18X20, int Len) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_READ_SP, owADDR_MATCH, 0) == 0)
+	if (OWResetCommand(&psDS18X20->sOW, DS18X20_READ_SP, OWP_BusAddrMode(&psDS18X20->sOW), 0) == 0)
 		return 0;
 	OWReadBlock(&psDS18X20->sOW, psDS18X20->RegX, Len);
 	IF_PXL(debugSPAD, "%'-hhY ", Len, psDS18X20->RegX);
@@ -111,7 +113,7 @@ int	ds18x20ReadSP(ds18x20_t * psDS18X20, int Len) {
 }
 
 int	ds18x20WriteSP(ds18x20_t * psDS18X20) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_WRITE_SP, owADDR_MATCH, 0) == 0)
+	if (OWResetCommand(&psDS18X20->sOW, DS18X20_WRITE_SP, OWP_BusAddrMode(&psDS18X20->sOW), 0) == 0)
 		return 0;
 	int Len = (psDS18X20->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_28) ? 3 : 2;	// Thi, Tlo [+Conf]
 	OWWriteBlock(&psDS18X20->sOW, (u8_t *) &psDS18X20->Thi, Len);
@@ -120,7 +122,7 @@ int	ds18x20WriteSP(ds18x20_t * psDS18X20) {
 }
 
 int	ds18x20WriteEE(ds18x20_t * psDS18X20) {
-	if (OWResetCommand(&psDS18X20->sOW, DS18X20_COPY_SP, owADDR_MATCH, 1) == 0)
+	if (OWResetCommand(&psDS18X20->sOW, DS18X20_COPY_SP, OWP_BusAddrMode(&psDS18X20->sOW), 1) == 0)
 		return 0;
 	vTaskDelay(pdMS_TO_TICKS(ds18x20DELAY_SP_COPY));
 	OWLevel(&psDS18X20->sOW, owPOWER_STANDARD);
@@ -140,7 +142,8 @@ int	ds18x20Initialize(ds18x20_t * psDS18X20) {
 	psDS18X20->Res	= (psDS18X20->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_28)
 					? psDS18X20->fam28.Conf >> 5
 					: owFAM28_RES9B;
-	return ds18x20ConvertTemperature(psDS18X20);
+	ds18x20ConvertTemperature(psDS18X20);
+	return 1;
 }
 
 /**
@@ -157,18 +160,237 @@ int	ds18x20ResetConfig(ds18x20_t * psDS18X20) {
 	return ds18x20Initialize(psDS18X20);
 }
 
-int	ds18x20ConvertTemperature(ds18x20_t * psDS18X20) {
+/**
+ * @brief	Return the last scratchpad sample in raw units, see ds18x20RAW_DIV()
+ * @note	DS18B20 bits undefined at the configured resolution are masked, the DS18S20 register
+ *			(1/2 C per LSB) has no undefined bits.
+ */
+static i16_t ds18x20RawValue(ds18x20_t * psDS18X20) {
 	const u8_t u8Mask[4] = { 0xF8, 0xFC, 0xFE, 0xFF };
+	u8_t Mask = (psDS18X20->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_28) ? u8Mask[psDS18X20->Res] : 0xFF;
+	return (i16_t) ((psDS18X20->Tmsb << 8) | (psDS18X20->Tlsb & Mask));
+}
+
+/**
+ * @brief	Normalise the raw sample, publish to the endpoint ONLY on change
+ * @param	psDS18X20
+ * @return	1 if the value was published, 0 if suppressed (within deadband, not silent too long)
+ * @note	A publication sets Upd, the endpoint sense/log pass consumes it with ds18x20Updated()
+ *			and skips sensors with nothing new.
+ */
+int	ds18x20ConvertTemperature(ds18x20_t * psDS18X20) {
 	report_t sRprt = { .pcBuf=NULL, .Size=0, .sFM.u32Val=makeMASK09x23(1,0,0,0,0,0,0,0,0,psDS18X20->Idx) };
-	u16_t u16Adj = (psDS18X20->Tmsb << 8) | (psDS18X20->Tlsb & u8Mask[psDS18X20->Res]);
-	psDS18X20->sEWx.var.val.x32.f32 = (float) u16Adj / 16.0;
+	i16_t Traw = ds18x20RawValue(psDS18X20);
+	TickType_t tNow = xTaskGetTickCount();
+	psDS18X20->Tsmpl = tNow;
+	i32_t Delta = Traw - psDS18X20->Tpub;
+	if (Delta < 0)
+		Delta = -Delta;
+	if (psDS18X20->Pub && (Delta < psDS18X20->Dband) &&
+		((tNow - psDS18X20->Tlast) < ((TickType_t) psDS18X20->Tmax * configTICK_RATE_HZ)))
+		return 0;
+	psDS18X20->Tpub = Traw;
+	psDS18X20->Tlast = tNow;
+	psDS18X20->Pub = 1;
+	psDS18X20->sEWx.var.val.x32.f32 = (float) Traw / ds18x20RAW_DIV(psDS18X20);
+	__atomic_store_n(&psDS18X20->Upd, 1, __ATOMIC_RELEASE);
 	if (debugTRACK && xOptionGet(dbgDS1820))
 		ds18x20Print_CB(&sRprt, psDS18X20);
 	return 1;
 }
 
+// ################################## Sample history support #######################################
+
+/* Each sensor has a ring of 2 byte slots holding the delta (value & time) from the previous sample,
+ * the oldest sample (base) and newest (head) are kept in full. A delta that does not fit (value
+ * outside +-127 or time > 255 Sec) is stored as an escape slot followed by the absolute value and
+ * a 16 bit delta time, a time gap too long for that restarts the history. Sum/Min/Max are updated
+ * on insert, Min/Max only rescanned when an extreme is evicted.
+ */
+
+#if (ds18x20HIST_SIZE > 0)
+#define	ds18x20HIST_ESC				INT8_MIN
+DUMB_STATIC_ASSERT(INRANGE(3, ds18x20HIST_SIZE, 255));
+
+static ds18x20hist_t * psaDS18X20H = NULL;
+static SemaphoreHandle_t HistMux = NULL;				// writers (read chain, StartAllInOne) vs readers
+
+/**
+ * @brief	Decode the record at slot Idx, update V & T to those of the next sample
+ * @return	number of slots consumed (1 or 3)
+ */
+static int ds18x20HistNext(ds18x20hist_t * psH, int Idx, i16_t * pV, seconds_t * pT) {
+	ds18x20rec_t * psR = &psH->Rec[Idx];
+	if (psR->dV != ds18x20HIST_ESC) {
+		*pV += psR->dV;
+		*pT += psR->dT;
+		return 1;
+	}
+	*pV = psH->Rec[(Idx + 1) % ds18x20HIST_SIZE].V;
+	*pT += psH->Rec[(Idx + 2) % ds18x20HIST_SIZE].T;
+	return 3;
+}
+
+static void ds18x20HistRescan(ds18x20hist_t * psH) {
+	i16_t V = psH->Vbase;
+	seconds_t T = psH->Tbase;
+	psH->Vmin = psH->Vmax = V;
+	for (int i = 0; i < psH->Used; ) {
+		i += ds18x20HistNext(psH, (psH->Tail + i) % ds18x20HIST_SIZE, &V, &T);
+		if (V < psH->Vmin)
+			psH->Vmin = V;
+		if (V > psH->Vmax)
+			psH->Vmax = V;
+	}
+}
+
+static void ds18x20HistEvict(ds18x20hist_t * psH) {
+	i16_t Vold = psH->Vbase;
+	int Len = ds18x20HistNext(psH, psH->Tail, &psH->Vbase, &psH->Tbase);
+	psH->Tail = (psH->Tail + Len) % ds18x20HIST_SIZE;
+	psH->Used -= Len;
+	psH->Sum -= Vold;
+	--psH->Count;
+	if (Vold == psH->Vmin || Vold == psH->Vmax)
+		ds18x20HistRescan(psH);
+}
+
+static void ds18x20HistPut(ds18x20hist_t * psH, ds18x20rec_t sRec) {
+	psH->Rec[(psH->Tail + psH->Used++) % ds18x20HIST_SIZE] = sRec;
+}
+
+static void ds18x20HistAdd(ds18x20_t * psDS18X20) {
+	ds18x20hist_t * psH = &psaDS18X20H[psDS18X20 - psaDS18X20];
+	i16_t V = ds18x20RawValue(psDS18X20);
+	seconds_t T = xTimeStampSeconds(sTSZ.usecs);
+	xRtosSemaphoreTake(&HistMux, portMAX_DELAY);
+	u32_t dT = T - psH->Thead;
+	i32_t dV = V - psH->Vhead;
+	if (psH->Count == 0 || dT > 0xFFFF) {				// first sample, gap too long or time reversed
+		psH->Tbase = T;
+		psH->Vbase = psH->Vmin = psH->Vmax = V;
+		psH->Sum = psH->Count = psH->Tail = psH->Used = 0;
+	} else {
+		int Need = (INRANGE(-127, dV, 127) && dT <= 0xFF) ? 1 : 3;
+		while ((ds18x20HIST_SIZE - psH->Used) < Need)
+			ds18x20HistEvict(psH);
+		if (Need == 1) {
+			ds18x20HistPut(psH, (ds18x20rec_t) { .dV = dV, .dT = dT });
+		} else {
+			ds18x20HistPut(psH, (ds18x20rec_t) { .dV = ds18x20HIST_ESC, .dT = 0 });
+			ds18x20HistPut(psH, (ds18x20rec_t) { .V = V });
+			ds18x20HistPut(psH, (ds18x20rec_t) { .T = dT });
+		}
+		if (V < psH->Vmin)
+			psH->Vmin = V;
+		if (V > psH->Vmax)
+			psH->Vmax = V;
+	}
+	psH->Thead = T;
+	psH->Vhead = V;
+	psH->Sum += V;
+	++psH->Count;
+	xRtosSemaphoreGive(&HistMux);
+}
+
+int	ds18x20HistRead(int Idx, seconds_t Tfrom, seconds_t Tto, ds18x20smpl_t * psBuf, int Size) {
+	IF_myASSERT(debugPARAM, halMemorySRAM((void*) psBuf));
+	if (psaDS18X20H == NULL || !INRANGE(0, Idx, Fam10_28Count - 1))
+		RETURN_MX("Invalid sensor", erINV_VALUE);
+	ds18x20hist_t * psH = &psaDS18X20H[Idx];
+	xRtosSemaphoreTake(&HistMux, portMAX_DELAY);
+	i16_t V = psH->Vbase;
+	seconds_t T = psH->Tbase;
+	int Num = 0;
+	for (int i = 0; psH->Count && Num < Size && T <= Tto; ) {
+		if (T >= Tfrom) {
+			psBuf[Num].Tsec = T;
+			psBuf[Num].Traw = V;
+			++Num;
+		}
+		if (i >= psH->Used)
+			break;
+		i += ds18x20HistNext(psH, (psH->Tail + i) % ds18x20HIST_SIZE, &V, &T);
+	}
+	xRtosSemaphoreGive(&HistMux);
+	return Num;
+}
+
+int	ds18x20HistStats(int Idx, seconds_t Tfrom, seconds_t Tto, ds18x20stat_t * psStat) {
+	IF_myASSERT(debugPARAM, halMemorySRAM((void*) psStat));
+	if (psaDS18X20H == NULL || !INRANGE(0, Idx, Fam10_28Count - 1))
+		RETURN_MX("Invalid sensor", erINV_VALUE);
+	ds18x20hist_t * psH = &psaDS18X20H[Idx];
+	memset(psStat, 0, sizeof(ds18x20stat_t));
+	xRtosSemaphoreTake(&HistMux, portMAX_DELAY);
+	if (psH->Count && Tfrom <= psH->Tbase && Tto >= psH->Thead) {	// whole history, running aggregates
+		psStat->Tfirst = psH->Tbase;
+		psStat->Tlast = psH->Thead;
+		psStat->Vmin = psH->Vmin;
+		psStat->Vmax = psH->Vmax;
+		psStat->Vavg = psH->Sum / psH->Count;
+		psStat->Count = psH->Count;
+	} else if (psH->Count) {							// part of it, walk the window
+		i16_t V = psH->Vbase;
+		seconds_t T = psH->Tbase;
+		i32_t Sum = 0;
+		for (int i = 0; T <= Tto; ) {
+			if (T >= Tfrom) {
+				if (psStat->Count == 0) {
+					psStat->Tfirst = T;
+					psStat->Vmin = psStat->Vmax = V;
+				}
+				psStat->Tlast = T;
+				if (V < psStat->Vmin)
+					psStat->Vmin = V;
+				if (V > psStat->Vmax)
+					psStat->Vmax = V;
+				Sum += V;
+				++psStat->Count;
+			}
+			if (i >= psH->Used)
+				break;
+			i += ds18x20HistNext(psH, (psH->Tail + i) % ds18x20HIST_SIZE, &V, &T);
+		}
+		if (psStat->Count)
+			psStat->Vavg = Sum / psStat->Count;
+	}
+	xRtosSemaphoreGive(&HistMux);
+	return psStat->Count;
+}
+#else
+	#define	ds18x20HistAdd(x)
+#endif
+
 // ################################ Rules configuration support ####################################
 
+/**
+ * @brief	Set the publication deadband & maximum silence for a range of sensors
+ * @param	Dband - minimum change (raw units, see ds18x20RAW_DIV) to publish, 0 = publish every sample
+ * @param	Tmax - maximum interval (Sec) between publications, even if unchanged
+ * @return	erSUCCESS or erINV_VALUE if invalid parameters
+ */
+int	ds18x20SetDeadband(int Xcur, int Xmax, int Dband, int Tmax) {
+	if (psaDS18X20 == NULL)
+		RETURN_MX("No DS18x20 enumerated", erINV_OPERATION);
+	if (Xmax <= Xcur)
+		Xmax = Xcur + 1;
+	if (!INRANGE(0, Dband, 255) || !INRANGE(1, Tmax, 65535) || Xmax > Fam10_28Count)
+		RETURN_MX("Invalid range/deadband/silence", erINV_VALUE);
+	for (int i = Xcur; i < Xmax; ++i) {
+		psaDS18X20[i].Dband = Dband;
+		psaDS18X20[i].Tmax = Tmax;
+		psaDS18X20[i].Pub = 0;							// publish next sample using new limits
+	}
+	return erSUCCESS;
+}
+
+int	ds18x20Updated(int Idx) {
+	if (psaDS18X20 == NULL || Idx < 0 || Idx >= Fam10_28Count)
+		return erINV_INDEX;
+	return __atomic_exchange_n(&psaDS18X20[Idx].Upd, 0, __ATOMIC_ACQ_REL);
+}
+
 int	ds18x20SetResolution(ds18x20_t * psDS18X20, int Res) {
 	if (psDS18X20->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_28 && INRANGE(9, Res, 12)) {
 		Res -= 9;
@@ -194,41 +416,162 @@ int	ds18x20SetAlarms(ds18x20_t * psDS18X20, int Lo, int Hi) {
 	RETURN_MX("Invalid Lo/Hi alarm limits", erINV_VALUE);
 }
 
+/**
+ * @brief	Update the scratchpad mirror of a single sensor, write SP [and EE] if anything changed
+ * @return	erINV_VALUE if invalid parameters, 1 if written or 0 if nothing changed
+ * @note	Bus must be selected by the caller
+ */
+static int ds18x20ConfigOne(ds18x20_t * psDS18X20, int lo, int hi, int res, int wr) {
+	// Do resolution 1st since small range (9-12) a good test for valid parameter
+	int iRV = ds18x20SetResolution(psDS18X20, res);
+	if (iRV < erSUCCESS)
+		return iRV;
+	int iRVx = ds18x20SetAlarms(psDS18X20, lo, hi);
+	if (iRVx < erSUCCESS)
+		return iRVx;
+	if (iRV == 0 && iRVx == 0)
+		return 0;										// nothing changed in scratchpad
+	iRV = ds18x20WriteSP(psDS18X20);
+	if (wr == 1)
+		ds18x20WriteEE(psDS18X20);
+	return iRV;
+}
+
+/**
+ * @brief	Configure ALL DS18x20 on a bus using a single SKIP ROM WRITE_SP [+ COPY_SP]
+ * @param	Xcur/Xmax - range of sensors, only those on LogBus are handled
+ * @return	erINV_VALUE if invalid parameters, else number of sensors configured
+ * @note	ONLY valid if the sensors in range are the complete static population of the bus, all
+ *			the same family (DS18S20 takes 2, DS18B20 3 bytes) and no iButton ever seen on the bus.
+ *			Every sensor is verified with a full SP read (+CRC), exceptions are rewritten individually.
+ */
+static int ds18x20ConfigBus(int Xcur, int Xmax, int LogBus, int lo, int hi, int res, int wr) {
+	ds18x20_t * psFirst = NULL;
+	for (int i = Xcur; i < Xmax && psFirst == NULL; ++i) {
+		if (OWP_BusP2L(&psaDS18X20[i].sOW) == LogBus)
+			psFirst = &psaDS18X20[i];
+	}
+	// select before touching the mirrors, a failed select must leave them as the devices hold
+	if (psFirst == NULL || OWP_BusSelect(&psFirst->sOW) == 0)
+		return 0;
+	int Count = 0;
+	for (int i = Xcur; i < Xmax; ++i) {					// validate & update all mirrors first
+		ds18x20_t * psDS18X20 = &psaDS18X20[i];
+		if (OWP_BusP2L(&psDS18X20->sOW) != LogBus)
+			continue;
+		int iRV = ds18x20SetResolution(psDS18X20, res);
+		int iRVx = (iRV < erSUCCESS) ? iRV : ds18x20SetAlarms(psDS18X20, lo, hi);
+		if (iRVx < erSUCCESS) {
+			OWP_BusRelease(&psFirst->sOW);
+			return iRVx;
+		}
+		if (iRV == 1 || iRVx == 1)
+			++Count;
+	}
+	if (Count == 0) {
+		OWP_BusRelease(&psFirst->sOW);
+		return 0;										// nothing changed
+	}
+	bool bFam28 = (psFirst->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_28);
+	u8_t Thi = psFirst->Thi, Tlo = psFirst->Tlo, Conf = psFirst->fam28.Conf;
+	if (OWResetCommand(&psFirst->sOW, DS18X20_WRITE_SP, owADDR_SKIP, 0) == 1) {
+		OWWriteBlock(&psFirst->sOW, (u8_t *) &psFirst->Thi, bFam28 ? 3 : 2);	// Thi, Tlo [+Conf]
+		if (wr == 1 && OWResetCommand(&psFirst->sOW, DS18X20_COPY_SP, owADDR_SKIP, 1) == 1) {
+			vTaskDelay(pdMS_TO_TICKS(ds18x20DELAY_SP_COPY));	// ONE EE write cycle for the bus
+			OWLevel(&psFirst->sOW, owPOWER_STANDARD);
+		}
+	}
+	Count = 0;
+	for (int i = Xcur; i < Xmax; ++i) {					// verify, per device write on exception
+		ds18x20_t * psDS18X20 = &psaDS18X20[i];
+		if (OWP_BusP2L(&psDS18X20->sOW) != LogBus)
+			continue;
+		// Full SP read overwrites the mirror with what the device actually holds
+		if (ds18x20ReadSP(psDS18X20, SO_MEM(ds18x20_t, RegX)) == 1 && psDS18X20->Thi == Thi &&
+			psDS18X20->Tlo == Tlo && (bFam28 == 0 || psDS18X20->fam28.Conf == Conf)) {
+			++Count;
+			continue;
+		}
+		IF_PX(debugTRACK && xOptionGet(dbgMode), "SP verify failed #%d, rewriting\r\n", i);
+		psDS18X20->Thi = Thi;
+		psDS18X20->Tlo = Tlo;
+		if (bFam28)
+			psDS18X20->fam28.Conf = Conf;
+		if (ds18x20WriteSP(psDS18X20) == 1) {
+			if (wr == 1)
+				ds18x20WriteEE(psDS18X20);
+			++Count;
+		}
+	}
+	OWP_BusRelease(&psFirst->sOW);
+	return Count;
+}
+
+/**
+ * @brief	Configure alarm thresholds & resolution [and persist] for a range of sensors
+ * @return	erINV_VALUE if invalid parameters, else number of sensors configured
+ * @note	Buses where the range covers the whole (single family) population are configured in
+ *			bulk by ds18x20ConfigBus(), all other sensors are configured individually.
+ */
+int	ds18x20ConfigRange(int Xcur, int Xmax, int lo, int hi, int res, int wr) {
+	int Count = 0;
+	for (int i = Xcur; i < Xmax; ++i) {
+		int LogBus = OWP_BusP2L(&psaDS18X20[i].sOW), j, Num = 0, iRV = 0;
+		for (j = Xcur; j < i && OWP_BusP2L(&psaDS18X20[j].sOW) != LogBus; ++j);
+		if (j < i)
+			continue;									// bus already handled
+		for (j = i; j < Xmax; ++j) {
+			if (OWP_BusP2L(&psaDS18X20[j].sOW) == LogBus)
+				++Num;
+		}
+		owbi_t * psOW_CI = psOWP_BusGetPointer(LogBus);
+		if (Num > 1 && Num == psOW_CI->NumDev && psOW_CI->Fam01 == 0 && psOW_CI->Part == 0 &&
+			(psOW_CI->ds18b20 == 0 || psOW_CI->ds18s20 == 0)) {
+			iRV = ds18x20ConfigBus(i, Xmax, LogBus, lo, hi, res, wr);
+		} else {
+			for (j = i; j < Xmax; ++j) {
+				ds18x20_t * psDS18X20 = &psaDS18X20[j];
+				if (OWP_BusP2L(&psDS18X20->sOW) != LogBus || OWP_BusSelect(&psDS18X20->sOW) == 0)
+					continue;
+				int iRVx = ds18x20ConfigOne(psDS18X20, lo, hi, res, wr);
+				OWP_BusRelease(&psDS18X20->sOW);
+				if (iRVx < erSUCCESS) {
+					iRV = iRVx;
+					break;
+				}
+				iRV += iRVx;
+			}
+		}
+		if (iRV < erSUCCESS)
+			return iRV;
+		Count += iRV;
+	}
+	return Count;
+}
+
 int	ds18x20ConfigMode (struct rule_t * psR, int Xcur, int Xmax) {
 	if (psaDS18X20 == NULL)
 		RETURN_MX("No DS18x20 enumerated", erINV_OPERATION);
-	// support syntax mode /ow/ds18x20 idx lo hi res [1=persist]
-	int iRV = erFAILURE, iRVx = erFAILURE;
+	// support syntax mode /ow/ds18x20 idx lo hi res [1=persist [dband tmax]]
 	u8_t	AI = psR->ActIdx;
 	i32_t lo = psR->para.x32[AI][0].i32;
 	i32_t hi = psR->para.x32[AI][1].i32;
 	u32_t res = psR->para.x32[AI][2].u32;
 	u32_t wr = psR->para.x32[AI][3].u32;
-	IF_PX(debugTRACK && xOptionGet(dbgMode), "MODE 'DS18X20' Xcur=%d Xmax=%d lo=%ld hi=%ld res=%lu wr=%lu\r\n",
-			Xcur, Xmax, lo, hi, res, wr);
+	i32_t dband = psR->para.x32[AI][4].i32;
+	i32_t tmax = psR->para.x32[AI][5].i32;
+	IF_PX(debugTRACK && xOptionGet(dbgMode), "MODE 'DS18X20' Xcur=%d Xmax=%d lo=%ld hi=%ld res=%lu wr=%lu dband=%ld tmax=%ld\r\n",
+			Xcur, Xmax, lo, hi, res, wr, dband, tmax);
 
 	IF_RETURN_MX(wr != 0 && wr != 1, "Invalid persist flag, not 0/1", erINV_MODE);
-	do {
-		ds18x20_t * psDS18X20 = &psaDS18X20[Xcur];
-		if (OWP_BusSelect(&psDS18X20->sOW) == 1) {
-			// Do resolution 1st since small range (9-12) a good test for valid parameter
-			iRV = ds18x20SetResolution(psDS18X20, res);
-			if (iRV > erFAILURE) {
-				iRVx = ds18x20SetAlarms(psDS18X20, lo, hi);
-				if (iRVx > erFAILURE) {
-					if (iRV == 1 || iRVx == 1) {	// 1 or both changed in scratchpad
-						iRV = ds18x20WriteSP(psDS18X20);
-						if (wr == 1)
-							ds18x20WriteEE(psDS18X20);
-					}
-				}
-			}
-			OWP_BusRelease(&psDS18X20->sOW);
-		}
-		if (iRVx < erSUCCESS)
-			break;
-	} while (++Xcur < Xmax);
-	return iRV < erSUCCESS? iRV : iRVx;
+	if (Xmax <= Xcur)
+		Xmax = Xcur + 1;								// always handle at least Xcur
+	if (tmax) {											// deadband & silence given, tmax 0 = omitted
+		int iRV = ds18x20SetDeadband(Xcur, Xmax, dband, tmax);
+		if (iRV < erSUCCESS)
+			return iRV;
+	}
+	return ds18x20ConfigRange(Xcur, Xmax, lo, hi, res, wr);
 }
 
 // #################################### 1W Platform support ########################################
@@ -253,24 +596,58 @@ void ds18x20SetDefault(epw_t * psEWP, epw_t * psEWS) {
 	psEWP->Rsns = 0;	// Stop EWP sensing ,vEpConfigReset() will handle EWx
 }
 
+/**
+ * @brief	Calculate the scheduler tick, GCD of all sensor periods, so every deadline falls on a tick
+ * @return	tick period in mSec, never less than ds18x20T_SNS_MIN
+ */
+static u32_t ds18x20CalcTick(void) {
+	u32_t Tick = 0;
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		u32_t A = psaDS18X20[i].Tper, B = Tick;
+		while (B) {
+			u32_t T = A % B;
+			A = B;
+			B = T;
+		}
+		Tick = A;
+	}
+	if (Tick == 0)
+		return ds18x20T_SNS_NORM;
+	return (Tick < ds18x20T_SNS_MIN) ? ds18x20T_SNS_MIN : Tick;
+}
+
 void ds18x20SetSense(epw_t * psEWP, epw_t * psEWS) {
 	/* Optimal 1-Wire bus operation require that all devices (of a type) are detected
 	 * (and read) in a single bus scan. BUT, for the DS18x20 the temperature conversion
 	 * time is 750mSec (per bus or device) at normal (not overdrive) bus speed.
 	 * When we get here the psEWS structure will already having been configured with the
-	 * parameters as supplied, just check & adjust for validity & new min Tsns */
+	 * parameters as supplied, just check & adjust for validity, then keep the period in the
+	 * sensor and recalculate the EWP scheduler tick */
 	if (psEWS->Tsns < ds18x20T_SNS_MIN)
 		psEWS->Tsns = ds18x20T_SNS_MIN;					// default to minimum
-	if (psEWS->Tsns < psEWP->Tsns)
-		psEWP->Tsns = psEWS->Tsns;						// set lowest of EWP/EWS
+	ds18x20_t * psDS18X20 = &psaDS18X20[psEWS->idx];
+	psDS18X20->Tper = psEWS->Tsns;						// sensor keeps its own period
+	psDS18X20->Tdue = xTaskGetTickCount();				// and samples on the next tick
+	psEWP->Tsns = ds18x20CalcTick();					// tick = GCD of all periods
 	psEWS->Tsns = 0;									// discard EWS value
 	psEWP->Rsns = psEWP->Tsns;							// restart SNS timer
 }
 
+/**
+ * @brief	Collect DS18S20 & DS18B20 from a scan of all families, others are not counted
+ * @note	Idx & handle slots are final only after ds18x20Sort()
+ */
 int	ds18x20EnumerateCB(report_t * psR, owdi_t * psOW) {
+	u8_t Family = psOW->ROM.HexChars[owFAMILY];
+	if ((Family != OWFAMILY_10 && Family != OWFAMILY_28) || psR->sFM.uCount >= Fam10_28Count)
+		return 0;
 	ds18x20_t * psDS18X20 = &psaDS18X20[psR->sFM.uCount];
 	memcpy(&psDS18X20->sOW, psOW, sizeof(owdi_t));
+	psDS18X20->sOW.Pri = owPRI_PERIODIC;
 	psDS18X20->Idx = psR->sFM.uCount;
+	psDS18X20->Tper = ds18x20T_SNS_NORM;				// until configured, same as EWP default
+	psDS18X20->Dband = ds18x20DEADBAND_DEF;
+	psDS18X20->Tmax = ds18x20T_SILENT_MAX;
 
 	epw_t * psEWS = &psDS18X20->sEWx;
 	memset(psEWS, 0, sizeof(epw_t));
@@ -280,14 +657,37 @@ int	ds18x20EnumerateCB(report_t * psR, owdi_t * psOW) {
 	ds18x20Initialize(psDS18X20);
 
 	owbi_t * psOW_CI = psOWP_BusGetPointer(OWP_BusP2L(psOW));
-	switch(psOW->ROM.HexChars[owFAMILY]) {
-	case OWFAMILY_10: psOW_CI->ds18s20++; break;
-	case OWFAMILY_28: psOW_CI->ds18b20++; break;
-	default: IF_myASSERT(debugRESULT, 0);
-	}
+	if (Family == OWFAMILY_10)
+		psOW_CI->ds18s20++;
+	else
+		psOW_CI->ds18b20++;
 	return 1;											// number of devices enumerated
 }
 
+static u16_t ds18x20SortKey(ds18x20_t * psDS18X20) {
+	return (ds18x20DEV(&psDS18X20->sOW) << 8) | psDS18X20->sOW.PhyBus;
+}
+
+/**
+ * @brief	Order the sensors by ds18x20DEV() then PhyBus, the read chains walk each bridge's
+ *			sensors as one contiguous run. Then number them & add the device handles.
+ * @note	Insertion sort, stable: scan order is kept within a bus
+ */
+static void ds18x20Sort(int Num) {
+	for (int i = 1; i < Num; ++i) {
+		ds18x20_t sTmp = psaDS18X20[i];
+		u16_t Key = ds18x20SortKey(&sTmp);
+		int j = i;
+		for (; j > 0 && ds18x20SortKey(&psaDS18X20[j-1]) > Key; --j)
+			psaDS18X20[j] = psaDS18X20[j-1];
+		psaDS18X20[j] = sTmp;
+	}
+	for (int i = 0; i < Num; ++i) {
+		psaDS18X20[i].Idx = psaDS18X20[i].sEWx.idx = i;
+		OWP_DevAdd(&psaDS18X20[i].sOW, i);
+	}
+}
+
 int	ds18x20Enumerate(void) {
 	u8_t ds18x20NumDev = 0;
 	Fam10_28Count = Fam10Count + Fam28Count;
@@ -302,20 +702,29 @@ int	ds18x20Enumerate(void) {
 	psEWP->Tsns	= psEWP->Rsns = ds18x20T_SNS_NORM;
 	psEWP->uri = URI_DS18X20;							// Used in OWPlatformEndpoints()
 
-	psaDS18X20 = malloc(Fam10_28Count * sizeof(ds18x20_t));
-	memset(psaDS18X20, 0, Fam10_28Count * sizeof(ds18x20_t));
-	int	iRV = 0;
-	if (Fam10Count) {
-		iRV = OWP_Scan(OWFAMILY_10, ds18x20EnumerateCB);
-		if (iRV > 0) {
-			ds18x20NumDev += iRV;
-		}
+	psaDS18X20 = pvOWP_ArenaAlloc(Fam10_28Count * sizeof(ds18x20_t));
+	if (psaDS18X20 == NULL)
+		return erNO_MEM;
+	#if (ds18x20HIST_SIZE > 0)
+	psaDS18X20H = pvOWP_ArenaAlloc(Fam10_28Count * sizeof(ds18x20hist_t));
+	if (psaDS18X20H == NULL)
+		return erNO_MEM;
+	#endif
+	pCacheMux = pvOWP_ArenaAlloc(OWP_NumBusGet() * sizeof(SemaphoreHandle_t));	// created on first use
+	if (pCacheMux == NULL)
+		return erNO_MEM;
+	if (ReadQ == NULL) {
+		ReadQ = xQueueCreate(ds18x20READ_QLEN, sizeof(int));
+		if (ReadQ == NULL ||
+			xTaskCreate(ds18x20ReadTask, "ds18x20", ds18x20READ_STACK, NULL, ds18x20READ_PRIO, NULL) != pdPASS)
+			return erNO_MEM;
 	}
-	if (Fam28Count) {
-		iRV = OWP_Scan(OWFAMILY_28, ds18x20EnumerateCB);
-		if (iRV > 0) {
-			ds18x20NumDev += iRV;
-		}
+	/* One scan of all families: a scan per family restarted the running count (the slot index)
+	 * at 0, the DS18B20 overwrote the DS18S20 entries */
+	int	iRV = OWP_Scan(0, ds18x20EnumerateCB);
+	if (iRV > 0) {
+		ds18x20NumDev = iRV;
+		ds18x20Sort(ds18x20NumDev);
 	}
 	if (ds18x20NumDev == Fam10_28Count) {
 		iRV = ds18x20NumDev;
@@ -332,9 +741,9 @@ int	ds18x20Print_CB(report_t * psR, ds18x20_t * psDS18X20) {
 	psR->sFM.bNL = 0;
 	int iRV = OWP_Print1W_CB(psR, &psDS18X20->sOW);
 	psR->sFM.bNL = ((fm_t)U32val).bNL;
-	iRV += xReport(psR, " Traw=0x%04X/%.4fC Tlo=%d Thi=%d Res=%d",
+	iRV += xReport(psR, " Traw=0x%04X/%.4fC Tlo=%d Thi=%d Res=%d Tsns=%lu",
 		psDS18X20->Tmsb << 8 | psDS18X20->Tlsb,
-		psDS18X20->sEWx.var.val.x32.f32, psDS18X20->Tlo, psDS18X20->Thi, psDS18X20->Res+9);
+		psDS18X20->sEWx.var.val.x32.f32, psDS18X20->Tlo, psDS18X20->Thi, psDS18X20->Res+9, psDS18X20->Tper);
 	if (psDS18X20->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_28)
 		iRV += xReport(psR, " Conf=0x%02X %s", psDS18X20->fam28.Conf, ((psDS18X20->fam28.Conf >> 5) != psDS18X20->Res) ? "ERROR" : "OK");
 	if (psR->sFM.bNL)
@@ -355,39 +764,126 @@ TickType_t ds18x20CalcDelay(ds18x20_t * psDS18X20, bool All) {
 	return tConvert;
 }
 
+/**
+ * @brief	Latch sensors with a deadline within half a tick of now as due, advance their deadlines
+ * @param	psEWP - primary endpoint, Tsns is the scheduler tick
+ * @return	number of sensors due, newly latched plus those still waiting to be read
+ * @note	The slack groups sensors whose deadlines coincide into the same convert.
+ *			Due is only cleared once the sensor has been read: a read chain can take 750mS+ per bus,
+ *			so sensors on later buses are still pending when the next tick arrives and must not be
+ *			re-evaluated (and lost) meanwhile. Deadlines advance by Tper from the previous deadline
+ *			(no drift), resynchronised to now if a whole period was missed.
+ */
+static int ds18x20MarkDue(epw_t * psEWP) {
+	TickType_t tNow = xTaskGetTickCount();
+	TickType_t tSlack = pdMS_TO_TICKS(psEWP->Tsns) / 2;
+	int Count = 0;
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		ds18x20_t * psDS18X20 = &psaDS18X20[i];
+		if (psDS18X20->Due == 0 && (i32_t) (tNow + tSlack - psDS18X20->Tdue) >= 0) {
+			psDS18X20->Tdue += pdMS_TO_TICKS(psDS18X20->Tper);
+			if ((i32_t) (tNow - psDS18X20->Tdue) >= 0)
+				psDS18X20->Tdue = tNow + pdMS_TO_TICKS(psDS18X20->Tper);
+			psDS18X20->Due = 1;
+		}
+		Count += psDS18X20->Due;
+	}
+	return Count;
+}
+
+/**
+ * @brief	Find the next due sensor on the same 1-Wire master device, starting at index i
+ * @return	index of the sensor, Fam10_28Count if none
+ */
+static int ds18x20NextDue(int i) {
+	u8_t Dev = ds18x20DEV(&psaDS18X20[i].sOW);
+	for (; i < Fam10_28Count && ds18x20DEV(&psaDS18X20[i].sOW) == Dev; ++i) {
+		if (psaDS18X20[i].Due)
+			return i;
+	}
+	return Fam10_28Count;
+}
+
+/**
+ * @brief	Broadcast convert on the bus of psOW & wait for it to complete, bus released on return
+ * @param	psDS18X20 - any sensor on the bus, sets the convert delay
+ * @return	1 if converted, 0 if the command failed, -1 if the bus could not be selected
+ */
+static int ds18x20ConvertBus(owdi_t * psOW, ds18x20_t * psDS18X20) {
+	if (OWP_BusSelect(psOW) == 0)
+		return -1;
+	if (OWResetCommand(psOW, DS18X20_CONVERT, owADDR_SKIP, 1) == 0) {
+		OWP_BusRelease(psOW);
+		return 0;
+	}
+	if (psOW->PSU) {									// no strong pull-up, bus free during convert
+		OWP_BusRelease(psOW);
+		vTaskDelay(ds18x20CalcDelay(psDS18X20, 1));
+	} else {
+		vTaskDelay(ds18x20CalcDelay(psDS18X20, 1));
+		OWLevel(psOW, owPOWER_STANDARD);
+		OWP_BusRelease(psOW);							// keep locked for period of delay
+	}
+	return 1;
+}
+
 /**
  * @brief	Trigger convert (bus at a time) then read SP, normalise RAW value & persist in EPW
  * @param 	psEPW
- * @return
+ * @return	erSUCCESS
+ * @note	Sensors that published are flagged, see ds18x20Updated()
  */
 int	ds18x20StartAllInOne(epw_t * psEWP) {
 	u8_t	PrevBus = 0xFF;
+	ds18x20MarkDue(psEWP);
 	for (int i = 0; i < Fam10_28Count; ++i) {
 		ds18x20_t * psDS18X20 = &psaDS18X20[i];
+		if (psDS18X20->Due == 0)
+			continue;
 		if (psDS18X20->sOW.PhyBus != PrevBus) {
-			if (OWP_BusSelect(&psDS18X20->sOW) == 0)
+			int iRV = ds18x20ConvertBus(&psDS18X20->sOW, psDS18X20);
+			if (iRV < 0)
 				continue;
-			if (OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, owADDR_SKIP, 1) == 1) {
+			if (iRV == 1)
 				PrevBus = psDS18X20->sOW.PhyBus;
-				vTaskDelay(ds18x20CalcDelay(psDS18X20, 1));
-				OWLevel(&psDS18X20->sOW, owPOWER_STANDARD);
-				OWP_BusRelease(&psDS18X20->sOW);		// keep locked for period of delay
-			}
 		}
-		if (OWP_BusSelect(&psDS18X20->sOW) && ds18x20ReadSP(psDS18X20, 2)) {
-			ds18x20ConvertTemperature(psDS18X20);
-			OWP_BusRelease(&psDS18X20->sOW);			// TODO maybe simplify Release ?
+		if (OWP_BusSelect(&psDS18X20->sOW)) {
+			if (ds18x20ReadSP(psDS18X20, 2)) {
+				ds18x20HistAdd(psDS18X20);
+				ds18x20ConvertTemperature(psDS18X20);
+			} else
+				SL_ERR("Read/Convert failed");
+			OWP_BusRelease(&psDS18X20->sOW);
 		} else
 			SL_ERR("Read/Convert failed");
+		psDS18X20->Due = 0;
 	}
 	return erSUCCESS;
 }
 
+/**
+ * @brief	Return the (per master device) timer used to schedule step 3 after convert
+ */
+static TimerHandle_t ds18x20BusTimer(owdi_t * psOW) {
+	#if (halRMT_1W > 0)
+	if (psOW->Type == owBUS_RMT)
+		return psaRMT[psOW->DevNum].th;
+	#endif
+	#if (HAL_DS2480B > 0)
+	if (psOW->Type == owBUS_DS2480B)
+		return psaDS2480B[psOW->DevNum].th;
+	#endif
+	return psaDS248X[psOW->DevNum].th;
+}
+
 int	ds18x20StepTwoBusConvert(ds18x20_t * psDS18X20, int i) {
 	if (OWP_BusSelect(&psDS18X20->sOW) == 1) {
 		OWResetCommand(&psDS18X20->sOW, DS18X20_CONVERT, owADDR_SKIP, 1);
-		vTimerSetTimerID(psaDS248X[psDS18X20->sOW.DevNum].th, (void *) i);
-		xTimerStart(psaDS248X[psDS18X20->sOW.DevNum].th, ds18x20CalcDelay(psDS18X20, 1));
+		TimerHandle_t th = ds18x20BusTimer(&psDS18X20->sOW);
+		vTimerSetTimerID(th, (void *) i);
+		xTimerStart(th, ds18x20CalcDelay(psDS18X20, 1));
+		if (psDS18X20->sOW.PSU)							// no strong pull-up to maintain, free the
+			OWP_BusRelease(&psDS18X20->sOW);			// bus for the convert, re-selected in step 3
 		SL_DBG("Start Dev=%d Ch=%d", psDS18X20->sOW.DevNum, psDS18X20->sOW.PhyBus);
 		return 1;
 	}
@@ -396,45 +892,162 @@ int	ds18x20StepTwoBusConvert(ds18x20_t * psDS18X20, int i) {
 }
 
 int ds18x20Sense(epw_t * psEWx) {					// Step 1: Start CONVERT on each physical bus
-	u8_t PrevDev = 0xFF;							// where 1+ DS18x20 has been enumerated on.
-	for (int i = 0; i < Fam10_28Count; ++i) {		// Although sense is configured on primary level,
-		ds18x20_t * psDS18X20 = &psaDS18X20[i];		// log can be different for each instance
-		if (psDS18X20->sOW.DevNum != PrevDev) {
-			if (ds18x20StepTwoBusConvert(psDS18X20, i) == 1) {
-				PrevDev = psDS18X20->sOW.DevNum;
-			}
+	if (ds18x20MarkDue(psEWx) == 0)					// where 1+ DS18x20 is due for sampling.
+		return erSUCCESS;							// Sense is ticked on primary level, period &
+	u8_t PrevDev = 0xFF;							// log can be different for each instance
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		ds18x20_t * psDS18X20 = &psaDS18X20[i];
+		u16_t Bit = 1U << ds18x20DEV(&psDS18X20->sOW);
+		if (psDS18X20->Due && ds18x20DEV(&psDS18X20->sOW) != PrevDev &&
+			(__atomic_fetch_or(&ds18x20Busy, Bit, __ATOMIC_ACQ_REL) & Bit) == 0) {	// chain still running
+			if (ds18x20StepTwoBusConvert(psDS18X20, i) == 1)
+				PrevDev = ds18x20DEV(&psDS18X20->sOW);
+			else
+				__atomic_and_fetch(&ds18x20Busy, ~Bit, __ATOMIC_RELEASE);
 		}
 	}
 	return erSUCCESS;
 }
 
-void ds18x20StepThreeRead(TimerHandle_t pxHandle) {
-	int	i = (int) pvTimerGetTimerID(pxHandle);
-	do {												// Handle all sensors on this BUS
+/**
+ * @brief	Read all due sensors on the bus of sensor i, then start convert on the next bus (if any)
+ *			of the same master device, whose timer continues the chain
+ */
+static void ds18x20ReadChain(int i) {
+	u16_t Bit = 1U << ds18x20DEV(&psaDS18X20[i].sOW);
+	if (psaDS18X20[i].sOW.PSU && OWP_BusSelect(&psaDS18X20[i].sOW) == 0) {	// released in step 2
+		SL_ERR("Failed to reselect Dev=%d Ch=%d", psaDS18X20[i].sOW.DevNum, psaDS18X20[i].sOW.PhyBus);
+		__atomic_and_fetch(&ds18x20Busy, ~Bit, __ATOMIC_RELEASE);	// still Due, retried next tick
+		return;
+	}
+	do {												// Handle all DUE sensors on this BUS
 		ds18x20_t * psDS18X20 = &psaDS18X20[i];
-		if (ds18x20ReadSP(psDS18X20, 2) == 1) {
-			ds18x20ConvertTemperature(psDS18X20);
-		} else {
-			SL_ERR("Read/Convert failed");
+		if (psDS18X20->Due) {
+			if (ds18x20ReadSP(psDS18X20, 2) == 1) {
+				ds18x20HistAdd(psDS18X20);
+				ds18x20ConvertTemperature(psDS18X20);
+			} else {
+				SL_ERR("Read/Convert failed");
+			}
+			psDS18X20->Due = 0;
 		}
 		++i;
 		// no more sensors or different device - release bus, exit loop
-		if ((i == Fam10_28Count) || (psDS18X20->sOW.DevNum != psaDS18X20[i].sOW.DevNum)) {
+		if ((i == Fam10_28Count) || (ds18x20DEV(&psDS18X20->sOW) != ds18x20DEV(&psaDS18X20[i].sOW))) {
 			OWP_BusRelease(&psDS18X20->sOW);
 			break;
 		}
-		// more sensors, same device but new bus - release bus, start convert on new bus.
+		// more sensors, same device but new bus - release bus, start convert on next bus with due sensor(s).
 		if (psDS18X20->sOW.PhyBus != psaDS18X20[i].sOW.PhyBus) {
 			OWP_BusRelease(&psDS18X20->sOW);
-			ds18x20StepTwoBusConvert(&psaDS18X20[i], i);
+			i = ds18x20NextDue(i);
+			if (i < Fam10_28Count && ds18x20StepTwoBusConvert(&psaDS18X20[i], i) == 1)
+				return;									// chain continues in the next step 3
+			break;
+		}
+		// more sensors, same device and same bus, let waiting higher class (iButton) in first
+		if (OWP_BusYield(&psaDS18X20[i].sOW) != 1) {
+			OWP_BusRelease(&psaDS18X20[i].sOW);
 			break;
 		}
-		// more sensors, same device and same bus
 	} while  (i < Fam10_28Count);
+	__atomic_and_fetch(&ds18x20Busy, ~Bit, __ATOMIC_RELEASE);	// chain done, unread sensors still Due
+}
+
+static void ds18x20ReadTask(void * pvPara) {
+	int i;
+	while (1) {
+		if (xQueueReceive(ReadQ, &i, portMAX_DELAY) == pdTRUE)
+			ds18x20ReadChain(i);
+	}
 }
 
+/**
+ * @brief	Convert timer expired (timer daemon context), hand the chain to the read task
+ * @note	The chain blocks on bus locks & I2C, in the daemon it stalled every software timer
+ */
+void ds18x20StepThreeRead(TimerHandle_t pxHandle) {
+	int	i = (int) pvTimerGetTimerID(pxHandle);
+	if (ReadQ && xQueueSend(ReadQ, &i, 0) == pdTRUE)
+		return;
+	SL_ERR("Read queue full Dev=%d Ch=%d", psaDS18X20[i].sOW.DevNum, psaDS18X20[i].sOW.PhyBus);
+	if (psaDS18X20[i].sOW.PSU == 0)						// still held from step 2
+		OWP_BusRelease(&psaDS18X20[i].sOW);
+	__atomic_and_fetch(&ds18x20Busy, ~(1U << ds18x20DEV(&psaDS18X20[i].sOW)), __ATOMIC_RELEASE);
+}
+
+// ###################################### Cached read service ######################################
+
+static bool ds18x20CacheFresh(ds18x20_t * psDS18X20, u32_t MaxAge) {
+	return psDS18X20->Tsmpl && (xTaskGetTickCount() - psDS18X20->Tsmpl) <= pdMS_TO_TICKS(MaxAge);
+}
+
+int	ds18x20ReadCached(int Idx, u32_t MaxAge, i16_t * pRaw) {
+	if (pCacheMux == NULL)
+		return erINV_STATE;								// not enumerated
+	if (Idx < 0 || Idx >= Fam10_28Count)
+		return erINV_INDEX;
+	ds18x20_t * psDS18X20 = &psaDS18X20[Idx];
+	if (ds18x20CacheFresh(psDS18X20, MaxAge)) {
+		__atomic_add_fetch(&sCache.Hit, 1, __ATOMIC_RELAXED);
+		*pRaw = ds18x20RawValue(psDS18X20);
+		return erSUCCESS;
+	}
+	u8_t LogBus = OWP_BusP2L(&psDS18X20->sOW);
+	TickType_t tReq = xTaskGetTickCount();
+	xRtosSemaphoreTake(&pCacheMux[LogBus], portMAX_DELAY);
+	// whoever held the lock may have just refreshed it: fresh enough now, or sampled since asked
+	if (ds18x20CacheFresh(psDS18X20, MaxAge) || (psDS18X20->Tsmpl && (i32_t) (psDS18X20->Tsmpl - tReq) >= 0)) {
+		xRtosSemaphoreGive(&pCacheMux[LogBus]);
+		__atomic_add_fetch(&sCache.Coal, 1, __ATOMIC_RELAXED);
+		*pRaw = ds18x20RawValue(psDS18X20);
+		return erSUCCESS;
+	}
+	__atomic_add_fetch(&sCache.Miss, 1, __ATOMIC_RELAXED);
+	owdi_t sOW = psDS18X20->sOW;
+	sOW.Pri = owPRI_INTERACTIVE;						// someone is waiting for this answer
+	int iRV = erFAILURE;
+	if (ds18x20ConvertBus(&sOW, psDS18X20) == 1) {
+		for (int i = 0; i < Fam10_28Count; ++i) {		// every sensor on the bus, all converted
+			ds18x20_t * psX = &psaDS18X20[i];
+			if (OWP_BusP2L(&psX->sOW) != LogBus)
+				continue;
+			sOW = psX->sOW;								// same class as the convert
+			sOW.Pri = owPRI_INTERACTIVE;
+			if (OWP_BusSelect(&sOW) == 0)
+				continue;
+			if (ds18x20ReadSP(psX, 2) == 1) {			// raw sample only, publishing & history
+				psX->Tsmpl = xTaskGetTickCount();		// stay with the sense scheduler
+				if (psX == psDS18X20)
+					iRV = erSUCCESS;
+			}
+			OWP_BusRelease(&sOW);
+		}
+	}
+	xRtosSemaphoreGive(&pCacheMux[LogBus]);
+	if (iRV == erSUCCESS)
+		*pRaw = ds18x20RawValue(psDS18X20);
+	else
+		__atomic_add_fetch(&sCache.Fail, 1, __ATOMIC_RELAXED);
+	return iRV;
+}
+
+void ds18x20CacheStats(ds18x20cache_t * psStats) { *psStats = sCache; }
+
 // ######################################### Reporting #############################################
 
+void ds18x20Snapshot(owsnap_wr_t * psW) {
+	owsnap_temp_t * psT = pvOWP_SnapSection(psW, owsnapSEC_TEMP, sizeof(owsnap_temp_t), Fam10_28Count);
+	TickType_t tNow = xTaskGetTickCount();
+	for (int i = 0; psT && i < Fam10_28Count; ++i) {
+		ds18x20_t * psDS18X20 = &psaDS18X20[i];
+		u32_t Age = (tNow - psDS18X20->Tlast) / configTICK_RATE_HZ;
+		psT[i] = (owsnap_temp_t) { .Raw = ds18x20RawValue(psDS18X20), .Tpub = psDS18X20->Tpub,
+			.Age = (Age > 0xFFFF) ? 0xFFFF : Age, .LogBus = OWP_BusP2L(&psDS18X20->sOW),
+			.Res = psDS18X20->Res, .Pub = psDS18X20->Pub };
+	}
+}
+
 int ds18x20ReportAll(report_t * psR) {
 	report_t sRprt = { .pcBuf = NULL, .Size = 0, .sFM.u32Val = 0 };
 	if (psR == NULL)
@@ -447,7 +1060,8 @@ int ds18x20ReportAll(report_t * psR) {
 		iRV += ds18x20Print_CB(psR, &psaDS18X20[i]);
 	}
 	if (Fam10_28Count)
-		iRV += xReport(psR, strNL);
+		iRV += xReport(psR, "Cache Hit=%lu Miss=%lu Coal=%lu Fail=%lu" strNL strNL,
+			sCache.Hit, sCache.Miss, sCache.Coal, sCache.Fail);
 	return iRV;
 }
 
@@ -12,6 +12,13 @@
 #include "task_events.h"
 #include "utilitiesX.h"								// vShowActivity
 
+#if (ds1990xAUTH_LOAD > 0)
+	#include "esp_partition.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
 #define	debugFLAG					0xF000
 
 #define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
@@ -21,46 +28,353 @@
 
 // ###################################### General macros ###########################################
 
-#define	DS1990X_T_SNS			1000
+/* Sense is ticked at the FAST rate, each channel has its own deadline. A reader probe (nothing
+ * enumerated at boot) costs a single reset per idle poll and is polled at the FAST rate, as is any
+ * channel for T_HOT after a tag is read. A bus with sensors costs a targeted search per poll: it is
+ * polled at the SLOW rate, or the STATIC rate if it cannot host a reader (ds1990xNO_READER) and no
+ * iButton was ever seen on it. A channel reporting errors has its period doubled (from T_BKOF_MIN
+ * up to T_BKOF_MAX) on each poll that adds errors, and restored to normal on the first clean poll. */
+#define	DS1990X_T_SNS			50				// FAST rate, sense tick
+#define	DS1990X_T_SLOW			1000			// sensors & maybe a reader, never slower than the old fixed period
+#define	DS1990X_T_STATIC		5000
+#define	DS1990X_T_HOT			10000
+#define	DS1990X_T_BKOF_MIN		1000
+#define	DS1990X_T_BKOF_MAX		16000
 
 // ################################# Platform related variables ####################################
 
 u8_t Fam01Count = 0;
+static ds1990x_t * psaDS1990X = NULL;
+
+/* Authorised tags: sorted (flash) array searched binary, with a Bloom prefilter in RAM rejecting
+ * most unknown tags without touching flash. The prefilter is sized from the number of tags and
+ * built before the set is made active with a single pointer swap under the mutex, which lookups
+ * hold for their (uSec) duration. The replaced set is freed after the swap. */
+typedef struct ds1990xauth_t {
+	const u64_t * pTags;
+	u32_t Count;
+	u32_t Mask;							// prefilter bits - 1
+	u8_t Bloom[];
+} ds1990xauth_t;
+DUMB_STATIC_ASSERT((ds1990xBLOOM_MAX & (ds1990xBLOOM_MAX - 1)) == 0);
+
+static ds1990xauth_t * psAuth = NULL;				// active set, NULL until 1st loaded
+static SemaphoreHandle_t AuthMux = NULL;
+
+/* Tag events: single producer (Sense task) single consumer (the subscribed task) ring, lock free.
+ * Head and Tail are free running, each written by one side only. Both sides store their own index
+ * and then load the other's (seq_cst), so either the producer sees the ring was drained and
+ * notifies, or the consumer sees the new event before it stops draining. Without a subscriber
+ * nothing is queued (or counted lost), every accepted read notifies the Events task with its
+ * channel bit as before the ring existed, the channel's LastROM/LastRead being the interface. */
+DUMB_STATIC_ASSERT((ds1990xEVT_SIZE & (ds1990xEVT_SIZE - 1)) == 0);
+static ds1990xevt_t sEvt[ds1990xEVT_SIZE];
+static u32_t EvtHead = 0, EvtTail = 0, EvtSeq = 0, EvtLost = 0;
+static TaskHandle_t EvtSub = NULL;
 
 // ################################# Application support functions #################################
 
+static void ds1990xAuthLoad(void);
+
 void ds1990xConfig(void) {
 	epw_t * psEWP = &table_work[URI_DS1990X];
 	psEWP->var.def = SETDEF_CVAR(0,0,vtVALUE,cvU32,1,0,0);
 	psEWP->Tsns = psEWP->Rsns = DS1990X_T_SNS;
 	psEWP->uri = URI_DS1990X;		// Used in OWPlatformEndpoints()
+	int NumBus = OWP_NumBusGet();
+	psaDS1990X = pvOWP_ArenaAlloc(NumBus * sizeof(ds1990x_t));
+	if (psaDS1990X == NULL)
+		return;
 	IF_SYSTIMER_INIT(debugTIMING, stDS1990, stTICKS, "DS1990x", 1, 100);
+	ds1990xAuthLoad();
 	halEventUpdateDevice(devMASK_DS1990X, 1);
 }
 
+// ################################## Authorised tag support #######################################
+
+#define	ds1990xBLOOM_K			7				// bits set/tested per tag, optimal for 10 bits/tag
+#define	ds1990xBLOOM_MIN		1024
+
+static u64_t ds1990xAuthHash(u64_t ROM) {			// 64 bit finalizer, ROM serial is NOT uniform
+	ROM ^= ROM >> 33;
+	ROM *= 0xFF51AFD7ED558CCDULL;
+	ROM ^= ROM >> 33;
+	return ROM;
+}
+
+/**
+ * @brief	Set (Set = 1) or test (Set = 0) the Bloom bits of a tag
+ * @return	1 if all bits set (possibly in set), 0 if definitely not in set
+ */
+static int ds1990xBloom(ds1990xauth_t * psA, u64_t ROM, bool Set) {
+	u64_t Hash = ds1990xAuthHash(ROM);
+	u32_t H1 = (u32_t) Hash, H2 = (u32_t) (Hash >> 32) | 1;
+	for (int i = 0; i < ds1990xBLOOM_K; ++i) {
+		u32_t Bit = (H1 + i * H2) & psA->Mask;
+		if (Set)
+			psA->Bloom[Bit >> 3] |= 1 << (Bit & 7);
+		else if ((psA->Bloom[Bit >> 3] & (1 << (Bit & 7))) == 0)
+			return 0;
+	}
+	return 1;
+}
+
+int	ds1990xAuthSet(const u64_t * pTags, u32_t Count) {
+	IF_RETURN_MX(Count && pTags == NULL, "No tags", erINV_VALUE);
+	for (u32_t i = 1; i < Count; ++i) {
+		if (pTags[i - 1] >= pTags[i])
+			RETURN_MX("Tags not sorted", erINV_VALUE);
+	}
+	u32_t Bits = ds1990xBLOOM_MIN;
+	while (Bits < ds1990xBLOOM_MAX && Bits < (u64_t) Count * ds1990xBLOOM_BPT)
+		Bits <<= 1;
+	ds1990xauth_t * psNew = malloc(sizeof(ds1990xauth_t) + Bits / 8);
+	if (psNew == NULL)
+		RETURN_MX("No memory for prefilter", erNO_MEM);
+	memset(psNew->Bloom, 0, Bits / 8);
+	psNew->pTags = pTags;
+	psNew->Count = Count;
+	psNew->Mask = Bits - 1;
+	for (u32_t i = 0; i < Count; ++i)
+		ds1990xBloom(psNew, pTags[i], 1);
+	xRtosSemaphoreTake(&AuthMux, portMAX_DELAY);
+	ds1990xauth_t * psOld = psAuth;
+	psAuth = psNew;
+	xRtosSemaphoreGive(&AuthMux);
+	free(psOld);
+	SL_INFO("Authorised tags=%u prefilter=%u bits", Count, Bits);
+	return erSUCCESS;
+}
+
+/**
+ * @brief	Load the authorised tag set from the ds1990xAUTH_PART data partition, if present
+ * @note	The partition is memory mapped and stays mapped, the tags are never copied to RAM.
+ */
+static void ds1990xAuthLoad(void) {
+	#if (ds1990xAUTH_LOAD > 0)
+	const esp_partition_t * psPart = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ds1990xAUTH_PART);
+	if (psPart == NULL)
+		return;											// no tag partition, AuthCheck reports NONE
+	const u32_t * pHdr;
+	esp_partition_mmap_handle_t hMap;
+	if (esp_partition_mmap(psPart, 0, psPart->size, ESP_PARTITION_MMAP_DATA, (const void **) &pHdr, &hMap) != ESP_OK) {
+		SL_ERR("Map '%s' failed", ds1990xAUTH_PART);
+		return;
+	}
+	if (pHdr[0] != ds1990xAUTH_MAGIC || (8 + (u64_t) pHdr[1] * sizeof(u64_t)) > psPart->size ||
+		ds1990xAuthSet((const u64_t *) &pHdr[2], pHdr[1]) != erSUCCESS) {
+		SL_ERR("Invalid tag set in '%s'", ds1990xAUTH_PART);
+		esp_partition_munmap(hMap);
+	}
+	#endif
+}
+
+int	ds1990xAuthCheck(u64_t ROM) {
+	int iRV = ds1990xAUTH_NONE;
+	xRtosSemaphoreTake(&AuthMux, portMAX_DELAY);
+	if (psAuth) {
+		iRV = ds1990xAUTH_DENY;
+		if (ds1990xBloom(psAuth, ROM, 0)) {
+			u32_t Lo = 0, Hi = psAuth->Count;
+			while (Lo < Hi) {
+				u32_t Mid = Lo + (Hi - Lo) / 2;
+				if (psAuth->pTags[Mid] < ROM) {
+					Lo = Mid + 1;
+				} else if (psAuth->pTags[Mid] > ROM) {
+					Hi = Mid;
+				} else {
+					iRV = ds1990xAUTH_ALLOW;
+					break;
+				}
+			}
+		}
+	}
+	xRtosSemaphoreGive(&AuthMux);
+	return iRV;
+}
+
+// ##################################### Tag event support #########################################
+
+/**
+ * @brief	Add a tag event to the ring, notify the subscriber if the ring was empty
+ */
+static void ds1990xEventPut(u64_t ROM, seconds_t Time, u8_t LogChan, u8_t Auth) {
+	TaskHandle_t hSub = __atomic_load_n(&EvtSub, __ATOMIC_ACQUIRE);
+	if (hSub == NULL) {
+		if (EventsHandle)								// NULLed on Events task exit - Sense and Events
+			xTaskNotify(EventsHandle, 1UL << (LogChan + evtFIRST_OW), eSetBits);	// die in the same phase, unordered
+		return;
+	}
+	u32_t Head = EvtHead;								// only written by this (producer) side
+	u32_t Seq = EvtSeq++;
+	if ((Head - __atomic_load_n(&EvtTail, __ATOMIC_SEQ_CST)) >= ds1990xEVT_SIZE) {
+		__atomic_add_fetch(&EvtLost, 1, __ATOMIC_RELAXED);	// slow consumer
+		return;
+	}
+	sEvt[Head & (ds1990xEVT_SIZE - 1)] = (ds1990xevt_t) {
+		.ROM = ROM, .Time = Time, .Seq = Seq, .LogChan = LogChan, .Auth = Auth };
+	__atomic_store_n(&EvtHead, Head + 1, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&EvtTail, __ATOMIC_SEQ_CST) == Head)	// was empty
+		xTaskNotify(hSub, 1UL << (LogChan + evtFIRST_OW), eSetBits);
+}
+
+void ds1990xEventSubscribe(TaskHandle_t hTask) {
+	if (hTask)											// start with an empty ring, see ds1990xEventGet()
+		__atomic_store_n(&EvtTail, __atomic_load_n(&EvtHead, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+	__atomic_store_n(&EvtSub, hTask, __ATOMIC_RELEASE);
+}
+
+int	ds1990xEventGet(ds1990xevt_t * psEvt, int Max) {
+	u32_t Tail = EvtTail;								// only written by this (consumer) side
+	u32_t Head = __atomic_load_n(&EvtHead, __ATOMIC_SEQ_CST);
+	int Num = 0;
+	while (Tail != Head && Num < Max)
+		psEvt[Num++] = sEvt[Tail++ & (ds1990xEVT_SIZE - 1)];
+	__atomic_store_n(&EvtTail, Tail, __ATOMIC_SEQ_CST);
+	return Num;
+}
+
+u32_t ds1990xEventLost(void) { return __atomic_load_n(&EvtLost, __ATOMIC_RELAXED); }
+
+// ################################### Latency instrumentation #####################################
+
+#if (ds1990xLATENCY > 0)
+static const u16_t ds1990xLatBound[ds1990xLAT_BUCKETS] = {		// bucket upper bounds, mSec
+	10, 20, 50, 100, 200, 500, 1000, 2000, 5000, UINT16_MAX
+};
+
+/**
+ * @brief	Record touch -> posted latency, ONLY for a new touch (no tag on the previous poll)
+ * @note	The touch happened after the last empty poll started, measured from there: an upper
+ *			bound that includes the wait for the next poll, which the poll rate determines
+ */
+static void ds1990xLatency(ds1990xlat_t * psL, TickType_t tValid) {
+	if (psL->Present || psL->Empty == 0)
+		return;
+	psL->Tvalid = tValid;
+	psL->Tpost = xTaskGetTickCount();
+	u32_t mS = (psL->Tpost - psL->Tempty) * portTICK_PERIOD_MS;
+	int i = 0;
+	while (i < (ds1990xLAT_BUCKETS - 1) && mS > ds1990xLatBound[i])
+		++i;
+	if (psL->Cnt[i] < UINT16_MAX)
+		++psL->Cnt[i];
+	if (mS > psL->Max)
+		psL->Max = mS;
+	++psL->Num;
+}
+
+/**
+ * @brief	Return the upper bound (mSec) of the bucket holding the Pct percentile
+ */
+static u32_t ds1990xLatPct(ds1990xlat_t * psL, int Pct) {
+	u32_t Want = (psL->Num * Pct + 99) / 100, Sum = 0;
+	for (int i = 0; i < (ds1990xLAT_BUCKETS - 1); ++i) {
+		Sum += psL->Cnt[i];
+		if (Sum >= Want)
+			return ds1990xLatBound[i] < psL->Max ? ds1990xLatBound[i] : psL->Max;
+	}
+	return psL->Max;
+}
+#endif
+
+int	ds1990xReportAll(report_t * psR) {
+	int iRV = 0;
+	#if (ds1990xLATENCY > 0)
+	if (psaDS1990X == NULL)
+		return iRV;
+	for (int LogBus = 0; LogBus < OWP_NumBusGet(); ++LogBus) {
+		ds1990xlat_t * psL = &psaDS1990X[LogBus].sLat;
+		if (psL->Num == 0)
+			continue;
+		if (iRV == 0)
+			iRV += xReport(psR, "\r# DS1990x touch to event latency (mSec) #\r\n");
+		iRV += xReport(psR, "L=%d  n=%lu  p50<=%lu  p95<=%lu  max=%lu  last=%lu+%lu+%lu\r\n", LogBus, psL->Num,
+			ds1990xLatPct(psL, 50), ds1990xLatPct(psL, 95), psL->Max,
+			(psL->Tpres - psL->Tempty) * portTICK_PERIOD_MS, (psL->Tvalid - psL->Tpres) * portTICK_PERIOD_MS,
+			(psL->Tpost - psL->Tvalid) * portTICK_PERIOD_MS);
+	}
+	#endif
+	return iRV;
+}
+
 // #################################### 1W Platform support ########################################
 
+/**
+ * @brief	Find a tag in the recent table of a channel, if not found replace least recently seen
+ * @return	pointer to entry, Hits == 0 if newly (re)created
+ * @note	Bounded by ds1990xLRU_SIZE, not by the number of tags in circulation
+ */
+static ds1990xtag_t * ds1990xTagFind(ds1990x_t * psDS1990X, u64_t ROM) {
+	ds1990xtag_t * psLRU = &psDS1990X->Tag[0];
+	for (int i = 0; i < ds1990xLRU_SIZE; ++i) {
+		ds1990xtag_t * psTag = &psDS1990X->Tag[i];
+		if (psTag->ROM == ROM)
+			return psTag;
+		if (psTag->ROM == 0 || (psLRU->ROM && psTag->Tseen < psLRU->Tseen))
+			psLRU = psTag;
+	}
+	memset(psLRU, 0, sizeof(ds1990xtag_t));
+	psLRU->ROM = ROM;
+	return psLRU;
+}
+
 /* To avoid registering multiple reads if iButton is held in place too long we enforce a
- * period of 'x' seconds within which successive reads of the same tag will be ignored */
+ * period of 'x' seconds within which successive reads of the same tag will be ignored.
+ * The last ds1990xLRU_SIZE tags are remembered per channel, alternating tags are also suppressed */
 int	ds1990SenseCB(report_t * psR, owdi_t * psOW) {
+	#if (ds1990xLATENCY > 0)
+	TickType_t tValid = xTaskGetTickCount();
+	#endif
 	seconds_t NowRead = xTimeStampSeconds(sTSZ.usecs);
 	u8_t LogChan = OWP_BusP2L(psOW);
 	owbi_t * psOW_CI = psOWP_BusGetPointer(LogChan);
+	ds1990xtag_t * psTag = ds1990xTagFind(&psaDS1990X[LogChan], psOW->ROM.Value);
 	u8_t Dly = xOptionGet(dlyDS1990);
-	if ((psOW_CI->LastROM.Value == psOW->ROM.Value) && (NowRead - psOW_CI->LastRead) <= Dly) {
-		IF_PX(debugTRACK && xOptionGet(dbgDS1990x), "Tag repeat %ds" strNL, Dly);
+	psOW_CI->Fam01 = 1;								// bus now dynamic, DS18x20 must use MATCH ROM
+	bool Repeat = psTag->Hits && (NowRead - psTag->Tacc) <= Dly;
+	psTag->Tseen = NowRead;
+	if (psTag->Hits < UINT16_MAX)
+		++psTag->Hits;
+	if (Repeat) {
+		IF_PX(debugTRACK && xOptionGet(dbgDS1990x), "Tag repeat %ds #%u" strNL, Dly, psTag->Hits);
 	} else {
-		IF_PX(debugTRACK && xOptionGet(dbgDS1990x), "Tag %-.8hhY L=%d P=%d" strNL, &psOW->ROM, LogChan, psOW->PhyBus);
+		psTag->Tacc = NowRead;
+		psTag->Auth = ds1990xAuthCheck(psOW->ROM.Value);
+		IF_PX(debugTRACK && xOptionGet(dbgDS1990x), "Tag %-.8hhY L=%d P=%d A=%d" strNL, &psOW->ROM, LogChan, psOW->PhyBus, psTag->Auth);
 		#if (ds248xSTAT_DEBUG > 0)					// accepted reads only: repeats above are NOT counted
-		++psaDS248X[psOW->DevNum].TagCnt[psOW->PhyBus];
+		if (psOW->Type == owBUS_DS248x)
+			++psaDS248X[psOW->DevNum].TagCnt[psOW->PhyBus];
 		#endif
 		psOW_CI->LastROM.Value = psOW->ROM.Value;
 		psOW_CI->LastRead = NowRead;
-		if (EventsHandle)								// NULLed on Events task exit - Sense and Events
-			xTaskNotify(EventsHandle, 1UL << (LogChan + evtFIRST_OW), eSetBits);	// die in the same phase, unordered
+		ds1990xEventPut(psOW->ROM.Value, NowRead, LogChan, psTag->Auth);
+		#if (ds1990xLATENCY > 0)
+		ds1990xLatency(&psaDS1990X[LogChan].sLat, tValid);
+		#endif
 		portYIELD();
 	}
-	return erSUCCESS;
+	return 1;										// tag present, repeat or not, keeps channel hot
+}
+
+/**
+ * @brief	Update the error backoff of a channel from the DS248x health counters
+ * @note	ErrSupp restarts each health report window, a decrease is treated as a new window.
+ */
+static void ds1990xHealth(ds1990x_t * psDS1990X, u8_t LogBus) {
+	#if (HAL_DS248X > 0)
+	owdi_t sOW;
+	OWP_BusL2P(&sOW, LogBus);
+	if (sOW.Type != owBUS_DS248x)					// no health counters on other backends
+		return;
+	u16_t ErrNow = ds248xChanErrors(sOW.DevNum, sOW.PhyBus);
+	u16_t ErrNew = (ErrNow >= psDS1990X->ErrPrv) ? ErrNow - psDS1990X->ErrPrv : ErrNow;
+	psDS1990X->ErrPrv = ErrNow;
+	if (ErrNew == 0)
+		psDS1990X->Tbkof = 0;
+	else if (psDS1990X->Tbkof < DS1990X_T_BKOF_MAX)
+		psDS1990X->Tbkof = psDS1990X->Tbkof ? psDS1990X->Tbkof * 2 : DS1990X_T_BKOF_MIN;
+	#endif
 }
 
 int	ds1990Sense(epw_t * psEWP) {
@@ -68,8 +382,39 @@ int	ds1990Sense(epw_t * psEWP) {
 	#if (HAL_DS248X > 0) && (ds248xCHAN_ATTRIB > 0)
 	ds248xAuditRun();								// I-3: deferred audits (boot baseline/degraded health)
 	#endif
-	int iRV = OWP_Scan(OWFAMILY_01, ds1990SenseCB);
+	int iRV = erSUCCESS;
+	TickType_t tNow = xTaskGetTickCount();
+	for (int LogBus = 0; LogBus < OWP_NumBusGet(); ++LogBus) {
+		ds1990x_t * psDS1990X = &psaDS1990X[LogBus];
+		if ((i32_t) (tNow - psDS1990X->Tnext) < 0)
+			continue;								// not yet due
+		#if (ds1990xLATENCY > 0)
+		TickType_t tPoll = xTaskGetTickCount();
+		if (psDS1990X->sLat.Present == 0)			// latch, held while the tag stays present
+			psDS1990X->sLat.Tpres = tPoll;
+		#endif
+		iRV = OWP_ScanBus(LogBus, OWFAMILY_01, ds1990SenseCB);	// idle probe = 1 reset, no search
+		if (iRV < erSUCCESS)
+			break;
+		#if (ds1990xLATENCY > 0)
+		if (iRV == 0) {								// no tag when this poll started
+			psDS1990X->sLat.Tempty = tPoll;
+			psDS1990X->sLat.Empty = 1;
+		}
+		psDS1990X->sLat.Present = (iRV > 0);
+		#endif
+		if (iRV > 0)
+			psDS1990X->Thot = tNow + pdMS_TO_TICKS(DS1990X_T_HOT);
+		ds1990xHealth(psDS1990X, LogBus);
+		owbi_t * psOWBI = psOWP_BusGetPointer(LogBus);
+		u32_t Tper = ((i32_t) (psDS1990X->Thot - tNow) > 0 || psOWBI->NumDev == 0) ? DS1990X_T_SNS
+				   : ((ds1990xNO_READER & (1ULL << LogBus)) && psOWBI->Fam01 == 0) ? DS1990X_T_STATIC
+				   : DS1990X_T_SLOW;
+		if (psDS1990X->Tbkof > Tper)
+			Tper = psDS1990X->Tbkof;
+		psDS1990X->Tnext = tNow + pdMS_TO_TICKS(Tper);
+	}
 	IF_SYSTIMER_STOP(debugTIMING, stDS1990);
-	return iRV;
+	return iRV < erSUCCESS ? iRV : erSUCCESS;
 }
 #endif
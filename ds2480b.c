@@ -0,0 +1,398 @@
+/*
+ * ds2480b.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * DS2480B serial 1-Wire line driver, see AN192 "Using the DS2480B Serial 1-Wire Line Driver"
+ */
+
+#include "hal_platform.h"
+
+#if (HAL_DS2480B > 0)
+#include "hal_memory.h"
+#include "onewire_platform.h"
+#include "report.h"
+#include "syslog.h"
+#include "systiming.h"								// timing debugging
+#include "errors_events.h"
+
+#include <string.h>
+
+// ###################################### General macros ###########################################
+
+#define	debugFLAG					0xF000
+
+#define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
+#define	debugTRACK					(debugFLAG_GLOBAL & debugFLAG & 0x2000)
+#define	debugPARAM					(debugFLAG_GLOBAL & debugFLAG & 0x4000)
+#define	debugRESULT					(debugFLAG_GLOBAL & debugFLAG & 0x8000)
+
+// ######################################## Build macros ###########################################
+
+#ifndef halDS2480B_UARTS
+	#error "halDS2480B_UARTS (eg { { 1, 17, 16 } } as Port, TXD, RXD) must be defined by the board"
+#endif
+
+#define	ds2480bUART_BUF				256				// driver RX & TX buffer sizes
+#define	ds2480bTIMEOUT				5				// mSec, plus 1mS per byte expected
+
+// ##################################### Local structures ##########################################
+
+typedef struct ds2480b_uart_t { u8_t Port, TxD, RxD; } ds2480b_uart_t;
+
+// ###################################### Local variables ##########################################
+
+static const u32_t ds2480bBaud[4] = { 9600, 19200, 57600, 115200 };	// indexed by ds2480bSET_? >> 1
+
+// ##################################### Global variables ##########################################
+
+u8_t ds2480bCount = 0;
+ds2480b_t * psaDS2480B = NULL;
+
+// ##################################### Forward declarations ######################################
+
+static int ds2480bDetect(ds2480b_t * psDS2480B);
+
+// #################################### UART exchange support ######################################
+
+/**
+ * @brief	Send TxLen bytes then wait for RxLen response bytes
+ * @return	1 if all response bytes received, else 0 after resync with the DS2480B
+ * @note	The DS2480B streams: a complete packet is written without waiting on individual responses
+ */
+static int ds2480bXfer(ds2480b_t * psDS2480B, const u8_t * pTx, int TxLen, u8_t * pRx, int RxLen) {
+	uart_flush_input(psDS2480B->Port);
+	if (uart_write_bytes(psDS2480B->Port, pTx, TxLen) == TxLen) {
+		if (RxLen == 0)
+			return 1;
+		int iRV = uart_read_bytes(psDS2480B->Port, pRx, RxLen, pdMS_TO_TICKS(ds2480bTIMEOUT + RxLen));
+		if (iRV == RxLen)
+			return 1;
+	}
+	++psDS2480B->ErrCnt;
+	SL_ERR("UART%d xfer failed, resync", psDS2480B->Port);
+	ds2480bDetect(psDS2480B);
+	return 0;
+}
+
+/**
+ * @brief	Add a mode switch to the packet if not already in the required mode
+ * @return	number of bytes added (0 or 1)
+ */
+static int ds2480bMode(ds2480b_t * psDS2480B, u8_t * pBuf, u8_t Mode) {
+	if (psDS2480B->Mode == Mode)
+		return 0;
+	psDS2480B->Mode = Mode;
+	*pBuf = Mode;
+	return 1;
+}
+
+static void ds2480bBreak(ds2480b_t * psDS2480B) {
+	uart_wait_tx_done(psDS2480B->Port, pdMS_TO_TICKS(ds2480bTIMEOUT));
+	uart_set_line_inverse(psDS2480B->Port, UART_SIGNAL_TXD_INV);	// TXD low = break, resets DS2480B
+	vTaskDelay(pdMS_TO_TICKS(3));
+	uart_set_line_inverse(psDS2480B->Port, UART_SIGNAL_INV_DISABLE);
+	vTaskDelay(pdMS_TO_TICKS(2));
+}
+
+/**
+ * @brief	Change the DS2480B then the host baud rate, verified by reading it back
+ * @return	1 if successful
+ */
+static int ds2480bChangeBaud(ds2480b_t * psDS2480B, u8_t Baud) {
+	if (psDS2480B->Baud == Baud)
+		return 1;
+	u8_t Pkt[2], Rx;
+	int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+	Pkt[Len++] = ds2480bCMD_CONFIG | ds2480bPARM_BAUDRATE | Baud;
+	uart_write_bytes(psDS2480B->Port, Pkt, Len);	// no response, DS2480B switches immediately
+	uart_wait_tx_done(psDS2480B->Port, pdMS_TO_TICKS(ds2480bTIMEOUT));
+	vTaskDelay(pdMS_TO_TICKS(5));
+	uart_set_baudrate(psDS2480B->Port, ds2480bBaud[Baud >> 1]);
+	psDS2480B->Baud = Baud;
+	vTaskDelay(pdMS_TO_TICKS(5));
+	Pkt[0] = ds2480bCMD_CONFIG | ds2480bPARM_READ | (ds2480bPARM_BAUDRATE >> 3);
+	uart_flush_input(psDS2480B->Port);
+	uart_write_bytes(psDS2480B->Port, Pkt, 1);
+	if (uart_read_bytes(psDS2480B->Port, &Rx, 1, pdMS_TO_TICKS(ds2480bTIMEOUT)) == 1 && (Rx & 0x0E) == Baud)
+		return 1;
+	SL_ERR("UART%d baud change failed", psDS2480B->Port);
+	return 0;
+}
+
+/**
+ * @brief	Reset the DS2480B (break + timing byte) at 9600 baud, load FLEX timing & verify
+ * @return	1 if DS2480B detected & responding at ds2480bBAUD
+ */
+static int ds2480bDetect(ds2480b_t * psDS2480B) {
+	psDS2480B->Mode = ds2480bMODE_COMMAND;
+	psDS2480B->Speed = ds2480bSPEED_FLEX;
+	psDS2480B->Baud = ds2480bSET_9600;
+	psDS2480B->SPU = psDS2480B->Pulse = 0;
+	uart_set_baudrate(psDS2480B->Port, ds2480bBaud[0]);
+	ds2480bBreak(psDS2480B);
+	u8_t Pkt[5] = { ds2480bTIMING_BYTE }, Rx[5];
+	uart_flush_input(psDS2480B->Port);
+	uart_write_bytes(psDS2480B->Port, Pkt, 1);
+	vTaskDelay(pdMS_TO_TICKS(2));
+	Pkt[0] = ds2480bCMD_CONFIG | ds2480bPARM_SLEW | ds2480bSLEW;
+	Pkt[1] = ds2480bCMD_CONFIG | ds2480bPARM_WRITE1LOW | ds2480bW1LT;
+	Pkt[2] = ds2480bCMD_CONFIG | ds2480bPARM_SAMPLEOFFSET | ds2480bDSO;
+	Pkt[3] = ds2480bCMD_CONFIG | ds2480bPARM_READ | (ds2480bPARM_BAUDRATE >> 3);	// test config block
+	Pkt[4] = ds2480bCMD_COMM | ds2480bFUNC_BIT | ds2480bSPEED_STD | ds2480bBITPOL_ONE;	// & 1-Wire block
+	uart_flush_input(psDS2480B->Port);
+	uart_write_bytes(psDS2480B->Port, Pkt, sizeof(Pkt));
+	if (uart_read_bytes(psDS2480B->Port, Rx, sizeof(Rx), pdMS_TO_TICKS(ds2480bTIMEOUT * 2)) != sizeof(Rx) ||
+		(Rx[3] & 0xF1) != 0x00 || (Rx[3] & 0x0E) != ds2480bSET_9600 || (Rx[4] & 0xF0) != 0x90) {
+		SL_ERR("UART%d DS2480B not detected", psDS2480B->Port);
+		return 0;
+	}
+	return ds2480bChangeBaud(psDS2480B, ds2480bBAUD);
+}
+
+// ################################### DS2480B debug/reporting #####################################
+
+int	ds2480bReport(report_t * psR, ds2480b_t * psDS2480B) {
+	return xReport(psR, "DS2480B UART%d  Baud=%lu  OD=%d  Err=%lu\r\n", psDS2480B->Port,
+		ds2480bBaud[psDS2480B->Baud >> 1], psDS2480B->Speed == ds2480bSPEED_OD, psDS2480B->ErrCnt);
+}
+
+int	ds2480bReportAll(report_t * psR) {
+	int iRV = 0;
+	for (int i = 0; i < ds2480bCount; iRV += ds2480bReport(psR, &psaDS2480B[i++]));
+	return iRV;
+}
+
+// ################################# DS2480B 1-Wire bus functions ##################################
+
+int	ds2480bBusSelect(ds2480b_t * psDS2480B) {
+	xRtosSemaphoreTake(&psDS2480B->mux, portMAX_DELAY);
+	return 1;
+}
+
+void ds2480bBusRelease(ds2480b_t * psDS2480B) { xRtosSemaphoreGive(&psDS2480B->mux); }
+
+int	ds2480bOWReset(ds2480b_t * psDS2480B) {
+	ds2480bOWLevel(psDS2480B, owPOWER_STANDARD);
+	u8_t Pkt[2], Rx;
+	int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+	Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_RESET | psDS2480B->Speed;
+	if (ds2480bXfer(psDS2480B, Pkt, Len, &Rx, 1) == 0)
+		return 0;
+	Rx &= ds2480bRB_RESET_MASK;
+	return (Rx == ds2480bRB_PRESENCE || Rx == ds2480bRB_ALARMPRESENCE) ? 1 : 0;
+}
+
+/**
+ * @brief	Switch between FLEX (standard) and overdrive speed, overdrive requires 115200 baud
+ * @return	current speed, owSPEED_STANDARD or owSPEED_ODRIVE
+ */
+int	ds2480bOWSpeed(ds2480b_t * psDS2480B, bool speed) {
+	u8_t Speed = speed ? ds2480bSPEED_OD : ds2480bSPEED_FLEX;
+	if (Speed != psDS2480B->Speed &&
+		(speed == owSPEED_STANDARD || ds2480bChangeBaud(psDS2480B, ds2480bSET_115200))) {
+		u8_t Pkt[2];
+		int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+		Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_SEARCHOFF | Speed;	// no response
+		if (ds2480bXfer(psDS2480B, Pkt, Len, NULL, 0))
+			psDS2480B->Speed = Speed;
+	}
+	return (psDS2480B->Speed == ds2480bSPEED_OD) ? owSPEED_ODRIVE : owSPEED_STANDARD;
+}
+
+/**
+ * @brief	Arm (applied after the next byte written, as the DS248x SPU) or end the strong pull-up
+ * @return	current level, owPOWER_STANDARD or owPOWER_STRONG
+ */
+int	ds2480bOWLevel(ds2480b_t * psDS2480B, bool level) {
+	if (level == owPOWER_STRONG) {
+		psDS2480B->SPU = 1;
+	} else if (psDS2480B->Pulse) {
+		u8_t Pkt[4], Rx[2];
+		int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+		Pkt[Len++] = ds2480bMODE_STOP_PULSE;
+		Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_CHMOD | ds2480bSPEED_PULSE;	// 5V, no prime
+		Pkt[Len++] = ds2480bMODE_STOP_PULSE;
+		if (ds2480bXfer(psDS2480B, Pkt, Len, Rx, 2) && (Rx[0] & 0xE0) == 0xE0 && (Rx[1] & 0xE0) == 0xE0)
+			psDS2480B->Pulse = 0;
+		psDS2480B->SPU = 0;
+	} else {
+		psDS2480B->SPU = 0;
+	}
+	return (psDS2480B->SPU || psDS2480B->Pulse) ? owPOWER_STRONG : owPOWER_STANDARD;
+}
+
+bool ds2480bOWTouchBit(ds2480b_t * psDS2480B, bool bit) {
+	u8_t Pkt[2], Rx;
+	int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+	Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_BIT | psDS2480B->Speed | (bit ? ds2480bBITPOL_ONE : 0);
+	if (ds2480bXfer(psDS2480B, Pkt, Len, &Rx, 1) == 0)
+		return 0;
+	return ((Rx & 0xE0) == 0x80) && ((Rx & ds2480bRB_BIT_MASK) == ds2480bRB_BIT_ONE);
+}
+
+/**
+ * @brief	Write a byte as 8 bit commands, the last priming the strong pull-up (AN192 OWWriteBytePower)
+ */
+static u8_t ds2480bOWWriteBytePower(ds2480b_t * psDS2480B, u8_t sendbyte) {
+	u8_t Pkt[10], Rx[9], Echo = 0;
+	int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+	Pkt[Len++] = ds2480bCMD_CONFIG | ds2480bPARM_5VPULSE | ds2480bSET_INFINITE;
+	for (int i = 0; i < 8; ++i)
+		Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_BIT | psDS2480B->Speed |
+			((sendbyte & (1 << i)) ? ds2480bBITPOL_ONE : 0) | ((i == 7) ? ds2480bPRIME5V : 0);
+	psDS2480B->SPU = 0;
+	if (ds2480bXfer(psDS2480B, Pkt, Len, Rx, 9) == 0 || (Rx[0] & 0x81) != 0)
+		return 0;
+	psDS2480B->Pulse = 1;
+	for (int i = 0; i < 8; ++i)
+		Echo |= (Rx[i + 1] & 0x01) << i;
+	return Echo;
+}
+
+u8_t ds2480bOWWriteByte(ds2480b_t * psDS2480B, u8_t sendbyte) {
+	if (psDS2480B->SPU)
+		return ds2480bOWWriteBytePower(psDS2480B, sendbyte);
+	u8_t Pkt[3], Rx;
+	int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_DATA);
+	Pkt[Len++] = sendbyte;
+	if (sendbyte == ds2480bMODE_COMMAND)			// escape data looking like a mode switch
+		Pkt[Len++] = sendbyte;
+	return ds2480bXfer(psDS2480B, Pkt, Len, &Rx, 1) ? Rx : 0;
+}
+
+u8_t ds2480bOWReadByte(ds2480b_t * psDS2480B) { return ds2480bOWWriteByte(psDS2480B, 0xFF); }
+
+/**
+ * @brief	Touch Len bytes in data mode, responses replace the bytes in pBuf
+ * @note	Sent as a single stream of up to ds2480bBLOCK_MAX bytes per exchange, no per byte waits
+ */
+static void ds2480bOWTouchBlock(ds2480b_t * psDS2480B, u8_t * pBuf, int Len) {
+	u8_t Pkt[1 + (2 * ds2480bBLOCK_MAX)];
+	while (Len > 0) {
+		int Cnt = (Len > ds2480bBLOCK_MAX) ? ds2480bBLOCK_MAX : Len;
+		int PktLen = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_DATA);
+		for (int i = 0; i < Cnt; ++i) {
+			Pkt[PktLen++] = pBuf[i];
+			if (pBuf[i] == ds2480bMODE_COMMAND)
+				Pkt[PktLen++] = pBuf[i];
+		}
+		if (ds2480bXfer(psDS2480B, Pkt, PktLen, pBuf, Cnt) == 0)
+			memset(pBuf, 0xFF, Cnt);
+		pBuf += Cnt;
+		Len -= Cnt;
+	}
+}
+
+void ds2480bOWWriteBlock(ds2480b_t * psDS2480B, u8_t * pBuf, int Len) {
+	u8_t Tmp[Len];									// write only, echo discarded
+	memcpy(Tmp, pBuf, Len);
+	ds2480bOWTouchBlock(psDS2480B, Tmp, Len);
+}
+
+void ds2480bOWReadBlock(ds2480b_t * psDS2480B, u8_t * pBuf, int Len) {
+	memset(pBuf, 0xFF, Len);
+	ds2480bOWTouchBlock(psDS2480B, pBuf, Len);
+}
+
+/**
+ * @brief	Search accelerator, resolve all 64 ROM bits in a single 16 byte exchange
+ * @param	LD - last discrepancy (1 based), bits below follow psROM, LD itself takes 1, above take 0
+ * @param	psROM - in: previous ROM, out: ROM found
+ * @param	pDisc - out: mask of bits where a discrepancy was resolved by taking the 0 path
+ * @return	1 if exchange completed (CRC to be checked by caller), else 0
+ * @note	Caller has already issued reset & the search command byte.
+ *			The direction bits occupy odd bit positions only, no byte can equal ds2480bMODE_COMMAND
+ */
+int	ds2480bOWSearch(ds2480b_t * psDS2480B, u8_t LD, ow_rom_t * psROM, u64_t * pDisc) {
+	u8_t Pkt[3 + 16 + 2], Rx[16];
+	int Len = ds2480bMode(psDS2480B, Pkt, ds2480bMODE_COMMAND);
+	Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_SEARCHON | psDS2480B->Speed;
+	Len += ds2480bMode(psDS2480B, &Pkt[Len], ds2480bMODE_DATA);
+	u8_t * pDir = &Pkt[Len];
+	memset(pDir, 0, 16);
+	for (int i = 0; i < 64; ++i) {
+		int Dir = (i + 1 < LD) ? (psROM->Value >> i) & 1 : (i + 1 == LD);
+		if (Dir)
+			pDir[(i * 2 + 1) / 8] |= 1 << ((i * 2 + 1) % 8);
+	}
+	Len += 16;
+	Len += ds2480bMode(psDS2480B, &Pkt[Len], ds2480bMODE_COMMAND);
+	Pkt[Len++] = ds2480bCMD_COMM | ds2480bFUNC_SEARCHOFF | psDS2480B->Speed;
+	if (ds2480bXfer(psDS2480B, Pkt, Len, Rx, sizeof(Rx)) == 0)
+		return 0;
+	u64_t ROM = 0, Disc = 0;
+	for (int i = 0; i < 64; ++i) {
+		u8_t Pair = (Rx[i / 4] >> ((i % 4) * 2)) & 0x03;	// b0 = discrepancy, b1 = path taken
+		if (Pair & 0x02)
+			ROM |= 1ULL << i;
+		else if (Pair & 0x01)
+			Disc |= 1ULL << i;
+	}
+	psROM->Value = ROM;
+	*pDisc = Disc;
+	return 1;
+}
+
+// ##################################### Backend ops table #########################################
+
+static int ds2480bOpsSelect(u8_t DevNum, u8_t Bus, u8_t Pri) { return ds2480bBusSelect(&psaDS2480B[DevNum]); }
+static void ds2480bOpsRelease(u8_t DevNum) { ds2480bBusRelease(&psaDS2480B[DevNum]); }
+static int ds2480bOpsReset(u8_t DevNum) { return ds2480bOWReset(&psaDS2480B[DevNum]); }
+static bool ds2480bOpsTouchBit(u8_t DevNum, bool Bit) { return ds2480bOWTouchBit(&psaDS2480B[DevNum], Bit); }
+static u8_t ds2480bOpsWriteByte(u8_t DevNum, u8_t Byte) { return ds2480bOWWriteByte(&psaDS2480B[DevNum], Byte); }
+static u8_t ds2480bOpsReadByte(u8_t DevNum) { return ds2480bOWReadByte(&psaDS2480B[DevNum]); }
+static void ds2480bOpsWriteBlock(u8_t DevNum, u8_t * pBuf, int Len) { ds2480bOWWriteBlock(&psaDS2480B[DevNum], pBuf, Len); }
+static void ds2480bOpsReadBlock(u8_t DevNum, u8_t * pBuf, int Len) { ds2480bOWReadBlock(&psaDS2480B[DevNum], pBuf, Len); }
+static int ds2480bOpsSearch(u8_t DevNum, u8_t LD, ow_rom_t * psROM, u64_t * pDisc) { return ds2480bOWSearch(&psaDS2480B[DevNum], LD, psROM, pDisc); }
+static int ds2480bOpsSpeed(u8_t DevNum, bool Spd) { return ds2480bOWSpeed(&psaDS2480B[DevNum], Spd); }
+static int ds2480bOpsLevel(u8_t DevNum, bool Pwr) { return ds2480bOWLevel(&psaDS2480B[DevNum], Pwr); }
+
+const ow_ops_t ds2480bOps = {
+	.Select = ds2480bOpsSelect,		.Release = ds2480bOpsRelease,
+	.Reset = ds2480bOpsReset,		.TouchBit = ds2480bOpsTouchBit,
+	.WriteByte = ds2480bOpsWriteByte,	.ReadByte = ds2480bOpsReadByte,
+	.WriteBlock = ds2480bOpsWriteBlock,	.ReadBlock = ds2480bOpsReadBlock,
+	.Search = ds2480bOpsSearch,		.Speed = ds2480bOpsSpeed,		.Level = ds2480bOpsLevel,
+	.Caps = owCAP_OVERDRIVE | owCAP_STRONG_PU | owCAP_SEARCH,
+};
+
+// ###################################### Configuration ############################################
+
+static int ds2480bInit(ds2480b_t * psDS2480B, const ds2480b_uart_t * psCfg) {
+	const uart_config_t sCfg = {
+		.baud_rate = 9600, .data_bits = UART_DATA_8_BITS, .parity = UART_PARITY_DISABLE,
+		.stop_bits = UART_STOP_BITS_1, .flow_ctrl = UART_HW_FLOWCTRL_DISABLE, .source_clk = UART_SCLK_DEFAULT,
+	};
+	psDS2480B->Port = psCfg->Port;
+	if (uart_driver_install(psCfg->Port, ds2480bUART_BUF, ds2480bUART_BUF, 0, NULL, 0) != ESP_OK ||
+		uart_param_config(psCfg->Port, &sCfg) != ESP_OK ||
+		uart_set_pin(psCfg->Port, psCfg->TxD, psCfg->RxD, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+		SL_ERR("UART%d config failed", psCfg->Port);
+		return erFAILURE;
+	}
+	if (ds2480bDetect(psDS2480B) == 0) {
+		uart_driver_delete(psCfg->Port);
+		return erINV_DEVICE;
+	}
+	#if (HAL_DS18X20 > 0)
+		void ds18x20StepThreeRead(TimerHandle_t);
+		psDS2480B->th = xTimerCreateStatic("tmrDS2480B", pdMS_TO_TICKS(5), pdFALSE, NULL, ds18x20StepThreeRead, &psDS2480B->ts);
+	#endif
+	return erSUCCESS;
+}
+
+int	ds2480bConfig(void) {
+	static const ds2480b_uart_t sUart[] = halDS2480B_UARTS;
+	const int Num = sizeof(sUart) / sizeof(sUart[0]);
+	if (psaDS2480B == NULL) {
+		psaDS2480B = pvOWP_ArenaAlloc(Num * sizeof(ds2480b_t));
+		if (psaDS2480B == NULL)
+			return erNO_MEM;
+	}
+	for (int i = 0; i < Num; ++i) {					// undetected ports are skipped, not counted
+		if (ds2480bInit(&psaDS2480B[ds2480bCount], &sUart[i]) == erSUCCESS)
+			++ds2480bCount;
+	}
+	SL_INFO("DS2480B %d/%d buses", ds2480bCount, Num);
+	return ds2480bCount;
+}
+#endif
@@ -0,0 +1,246 @@
+/*
+ * ds2480bpty.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * DS2480B stand-in on a linux pseudo-terminal, for host testing of ds2480b.c without the chip.
+ * A task serves the master side of the pty, speaking the DS2480B command & data mode protocol
+ * (datasheet, AN192) to whatever opens the slave side, eg the host UART port via uart_host_path().
+ * The 1-Wire bus behind it is channel 0 of a virtual device population of the DS248x simulator
+ * (ds248xsim.c), ds248xSIM_DS18B20/DS18S20/DS1990 devices at start.
+ * Not modelled: timing (speed, slew & pulse parameters are accepted and read back only), baud rate
+ * (a pty has none) and breaks (a pty drops them), so a resync only works from the power-on state.
+ */
+
+#if defined(__linux__)
+	#define	_GNU_SOURCE							// posix_openpt() & co, ptsname_r()
+#endif
+#include "hal_platform.h"
+
+#if (HAL_DS2480B > 0) && (ds248xSIMULATE > 0) && defined(__linux__)
+#include "hal_i2c_common.h"
+#include "onewire_platform.h"
+#include "syslog.h"
+#include "errors_events.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ###################################### General macros ###########################################
+
+#define	debugFLAG					0xF000
+
+#define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
+#define	debugTRACK					(debugFLAG_GLOBAL & debugFLAG & 0x2000)
+#define	debugPARAM					(debugFLAG_GLOBAL & debugFLAG & 0x4000)
+#define	debugRESULT					(debugFLAG_GLOBAL & debugFLAG & 0x8000)
+
+// ######################################## Build macros ###########################################
+
+#define	ds2480bPTY_CHAN				0				// virtual population channel used
+#define	ds2480bPTY_POLL				50				// mSec, stop request check interval
+#define	ds2480bPTY_PRIO				2
+
+#define	ds2480bPTY_PULSE_RSP		((ds2480bCMD_COMM | ds2480bFUNC_CHMOD | ds2480bSPEED_PULSE) & 0xFC)
+
+// ##################################### Local structures ##########################################
+
+typedef struct ds2480bpty_t {
+	struct i2c_di_t sKey;				// identifies the virtual device population
+	TaskHandle_t hTask;
+	int FD;								// master side
+	int FDslave;						// held open, the master reads EIO while no slave is open
+	u8_t Run;
+	u8_t Sync;							// timing byte received, the first byte after power-on
+	u8_t Mode;							// ds2480bMODE_DATA / ds2480bMODE_COMMAND
+	u8_t Esc;							// data mode, ds2480bMODE_COMMAND received, next byte decides
+	u8_t Search;						// search accelerator on
+	u8_t Pulse;							// strong pull-up active, response pending until stopped
+	u8_t PulseRsp;
+	u8_t Parm[8];						// configuration values, by parameter code
+	u8_t Rsp[256];						// responses to the bytes being processed
+	int RspLen;
+	char caPath[64];					// slave side
+} ds2480bpty_t;
+
+// ###################################### Local variables ##########################################
+
+static ds2480bpty_t sPty = { .FD = -1, .FDslave = -1 };
+
+// ################################## DS2480B protocol emulation ###################################
+
+static void ds2480bPtyReply(ds2480bpty_t * psP, u8_t Byte) {
+	if (psP->RspLen < sizeof(psP->Rsp))
+		psP->Rsp[psP->RspLen++] = Byte;
+}
+
+static bool ds2480bPtySlot(ds2480bpty_t * psP, bool Bit) {
+	return ds248xSimLineSlot(&psP->sKey, ds2480bPTY_CHAN, Bit);
+}
+
+/**
+ * @brief	Start a strong pull-up, infinite ones run until a stop pulse command
+ */
+static void ds2480bPtyPulse(ds2480bpty_t * psP, u8_t Rsp) {
+	if (psP->Parm[ds2480bPARM_5VPULSE >> 4] == (ds2480bSET_INFINITE >> 1)) {
+		psP->Pulse = 1;
+		psP->PulseRsp = Rsp;
+	} else {
+		ds2480bPtyReply(psP, Rsp);					// timed pulse, done before the next byte
+	}
+}
+
+static void ds2480bPtyCommand(ds2480bpty_t * psP, u8_t Cmd) {
+	if (Cmd == ds2480bMODE_DATA) {
+		psP->Mode = ds2480bMODE_DATA;
+	} else if (Cmd == ds2480bMODE_STOP_PULSE) {
+		if (psP->Pulse) {
+			psP->Pulse = 0;
+			ds2480bPtyReply(psP, psP->PulseRsp);
+		}
+	} else if (Cmd == ds2480bMODE_COMMAND || (Cmd & 0x01) == 0) {
+		// already in command mode, or not a command: ignored
+	} else if ((Cmd & ds2480bCMD_COMM) != ds2480bCMD_COMM) {	// configuration
+		u8_t Parm = (Cmd >> 4) & 0x07, Value = (Cmd >> 1) & 0x07;
+		if (Parm == (ds2480bPARM_READ >> 4)) {
+			ds2480bPtyReply(psP, psP->Parm[Value] << 1);
+		} else {
+			psP->Parm[Parm] = Value;
+			ds2480bPtyReply(psP, Cmd & 0xFE);
+		}
+	} else {
+		switch (Cmd & 0x60) {
+		case ds2480bFUNC_BIT: {
+			bool Bit = ds2480bPtySlot(psP, Cmd & ds2480bBITPOL_ONE);
+			ds2480bPtyReply(psP, (Cmd & 0xFC) | (Bit ? ds2480bRB_BIT_ONE : 0));
+			if (Cmd & ds2480bPRIME5V)
+				ds2480bPtyPulse(psP, ds2480bPTY_PULSE_RSP);
+			break;
+		}
+		case ds2480bFUNC_SEARCHOFF:					// & ds2480bFUNC_SEARCHON, no response
+			psP->Search = (Cmd & 0x10) ? 1 : 0;
+			break;
+		case ds2480bFUNC_RESET:
+			ds2480bPtyReply(psP, 0xCC | (ds248xSimLineReset(&psP->sKey, ds2480bPTY_CHAN)
+				? ds2480bRB_PRESENCE : ds2480bRB_RESET_MASK));
+			break;
+		case ds2480bFUNC_CHMOD:
+			ds2480bPtyPulse(psP, Cmd & 0xFC);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief	Data byte: 8 time slots, or with the search accelerator on 4 search steps. Each step
+ *			takes its direction from an odd bit, the response has the discrepancy flag in the even
+ *			and the direction taken in the odd bit.
+ */
+static void ds2480bPtyData(ds2480bpty_t * psP, u8_t Byte) {
+	u8_t Rsp = 0;
+	if (psP->Search) {
+		for (int i = 0; i < 4; ++i) {
+			bool Id = ds2480bPtySlot(psP, 1), Cmp = ds2480bPtySlot(psP, 1), Dir, Disc;
+			if (Id != Cmp) {
+				Dir = Id;
+				Disc = 0;
+			} else {
+				Dir = (Byte >> (i * 2 + 1)) & 1;
+				Disc = 1;
+			}
+			ds2480bPtySlot(psP, Dir);
+			Rsp |= (Disc << (i * 2)) | (Dir << (i * 2 + 1));
+		}
+	} else {
+		for (int i = 0; i < 8; ++i)
+			Rsp |= ds2480bPtySlot(psP, (Byte >> i) & 1) << i;
+	}
+	ds2480bPtyReply(psP, Rsp);
+}
+
+static void ds2480bPtyByte(ds2480bpty_t * psP, u8_t Byte) {
+	if (psP->Sync == 0) {							// ds2480bTIMING_BYTE, no response
+		psP->Sync = 1;
+	} else if (psP->Mode == ds2480bMODE_COMMAND) {
+		ds2480bPtyCommand(psP, Byte);
+	} else if (psP->Esc) {
+		psP->Esc = 0;
+		if (Byte == ds2480bMODE_COMMAND) {			// doubled, data
+			ds2480bPtyData(psP, Byte);
+		} else {
+			psP->Mode = ds2480bMODE_COMMAND;
+			ds2480bPtyCommand(psP, Byte);
+		}
+	} else if (Byte == ds2480bMODE_COMMAND) {
+		psP->Esc = 1;
+	} else {
+		ds2480bPtyData(psP, Byte);
+	}
+}
+
+// ######################################## pty service ############################################
+
+static void ds2480bPtyTask(void * pvPara) {
+	ds2480bpty_t * psP = pvPara;
+	u8_t Buf[64];
+	while (psP->Run) {
+		struct pollfd sPFD = { .fd = psP->FD, .events = POLLIN };
+		if (poll(&sPFD, 1, ds2480bPTY_POLL) <= 0 || (sPFD.revents & POLLIN) == 0)
+			continue;
+		int Len = read(psP->FD, Buf, sizeof(Buf));
+		if (Len <= 0)
+			continue;
+		psP->RspLen = 0;
+		for (int i = 0; i < Len; ++i)
+			ds2480bPtyByte(psP, Buf[i]);
+		if (psP->RspLen && write(psP->FD, psP->Rsp, psP->RspLen) != psP->RspLen)
+			SL_ERR("pty %s write failed", psP->caPath);
+	}
+	close(psP->FDslave);
+	close(psP->FD);
+	psP->FD = psP->FDslave = -1;
+	__atomic_store_n(&psP->hTask, NULL, __ATOMIC_RELEASE);
+	vTaskDelete(NULL);
+}
+
+const char * pcDS2480B_PtyOpen(void) {
+	ds2480bpty_t * psP = &sPty;
+	if (psP->hTask)
+		return psP->caPath;
+	psP->FD = posix_openpt(O_RDWR | O_NOCTTY);
+	if (psP->FD < 0 || grantpt(psP->FD) != 0 || unlockpt(psP->FD) != 0 ||
+		ptsname_r(psP->FD, psP->caPath, sizeof(psP->caPath)) != 0)
+		goto fail;
+	psP->FDslave = open(psP->caPath, O_RDWR | O_NOCTTY);
+	struct termios sTIO;
+	if (psP->FDslave < 0 || tcgetattr(psP->FDslave, &sTIO) != 0)
+		goto fail;
+	cfmakeraw(&sTIO);								// no echo before the UART opens it
+	tcsetattr(psP->FDslave, TCSANOW, &sTIO);
+	psP->Mode = ds2480bMODE_COMMAND;				// power-on state
+	psP->Sync = psP->Esc = psP->Search = psP->Pulse = 0;
+	memset(psP->Parm, 0, sizeof(psP->Parm));
+	psP->Run = 1;
+	if (xTaskCreate(ds2480bPtyTask, "ds2480bPty", 4096, psP, ds2480bPTY_PRIO, &psP->hTask) == pdPASS) {
+		SL_INFO("DS2480B stand-in on %s", psP->caPath);
+		return psP->caPath;
+	}
+fail:
+	SL_ERR("DS2480B pty failed");
+	if (psP->FDslave >= 0)
+		close(psP->FDslave);
+	if (psP->FD >= 0)
+		close(psP->FD);
+	psP->FD = psP->FDslave = -1;
+	return NULL;
+}
+
+void ds2480bPtyClose(void) {
+	ds2480bpty_t * psP = &sPty;
+	psP->Run = 0;
+	while (__atomic_load_n(&psP->hTask, __ATOMIC_ACQUIRE))
+		vTaskDelay(pdMS_TO_TICKS(ds2480bPTY_POLL));
+}
+#endif
@@ -34,6 +34,7 @@
 #define	ds248xLOCK_IO				1					// un/locked on I2C access level
 #define	ds248xLOCK_BUS				2					// un/locked on Bus select level
 #define	ds248xLOCK					ds248xLOCK_BUS
+#define	ds248xEG_TAKEN				(1UL << 0)			// lock taken by a class above BACKGROUND
 
 #define	dsERR_LOG_INTERVAL			pdMS_TO_TICKS(60000)	// rate limit: <=1 health report / device / minute
 #define	dsBACKOFF_MIN				pdMS_TO_TICKS(5000)		// I5: first WEDGED recovery retry after 5s
@@ -66,6 +67,18 @@ static int ResetOK = 0, ResetErr = 0, ResetBusy = 0;	// ResetBusy: DRST OK but 1
 
 enum { ds248xSTATE_OK, ds248xSTATE_ERR, ds248xSTATE_WEDGED };	// ds248x_t.State, owned by ds248xReportHealth()
 
+#if (ds248xTRACE > 0)
+/* Transaction trace: a binary ring filled at the ds248xWriteDelayRead() boundary, formatting only
+ * happens on dump. Whole-byte controls, written by the console/health side and read lock-free on
+ * the hot path; when disabled the only cost is the Ena load. Slots are claimed atomically since
+ * each device has its own lock and several can be mid-transfer at once. */
+static struct {
+	u8_t Ena, Freeze, DevMask, ChanMask, Cmd;
+} sTrcCtl = { .DevMask = 0xFF, .ChanMask = 0xFF };
+static u32_t TrcHead = 0;
+static ds248xtrc_t sTrc[ds248xTRACE_SIZE];
+#endif
+
 // ################################ Local ONLY utility functions ###################################
 
 static int ds248xWriteConfigRaw(ds248x_t * psDS248X, ds248x_conf_t sConf);	// fwd: used by ds248xLogError APU restore
@@ -136,14 +149,21 @@ static void ds248xReportHealth(ds248x_t * psDS248X) {
 	if (NewState != ds248xSTATE_OK)
 		psDS248X->AuditPend = 1;						// I-3: line-state audit on the next Sense pass
 	#endif
+	const char * pcTrc = "";
+	#if (ds248xTRACE > 0)
+	if (NewState > psDS248X->State && sTrcCtl.Ena && sTrcCtl.Freeze) {
+		sTrcCtl.Ena = 0;								// keep the lead-up to the escalation for dumping
+		pcTrc = "  trace=frozen";
+	}
+	#endif
 	SL_LOG((NewState == ds248xSTATE_WEDGED && psDS248X->State != ds248xSTATE_WEDGED) ? SL_SEV_ALERT :
 			NewState ? SL_SEV_ERROR : SL_SEV_NOTICE,
-		"Dev=%d  1W %s->%s  Ch=%u/%u/%u/%u/%u/%u/%u/%u  XErr=%u  Skip=%u  Bkof=%u  DRST=%d/%d/%d%s%s%s%s",
+		"Dev=%d  1W %s->%s  Ch=%u/%u/%u/%u/%u/%u/%u/%u  XErr=%u  Skip=%u  Bkof=%u  DRST=%d/%d/%d%s%s%s%s%s",
 		psDS248X->psI2C->DevIdx, StateName[psDS248X->State], StateName[NewState],
 		psDS248X->ErrSupp[0], psDS248X->ErrSupp[1], psDS248X->ErrSupp[2], psDS248X->ErrSupp[3],
 		psDS248X->ErrSupp[4], psDS248X->ErrSupp[5], psDS248X->ErrSupp[6], psDS248X->ErrSupp[7],
 		psDS248X->XErrCnt, psDS248X->SkipCnt, psDS248X->BkofCnt, ResetOK, ResetErr, ResetBusy,
-		psDS248X->LastMsg[0] ? "  last=" : "", psDS248X->LastMsg, caFirst,
+		psDS248X->LastMsg[0] ? "  last=" : "", psDS248X->LastMsg, caFirst, pcTrc,
 		(NewState == ds248xSTATE_WEDGED) ? "  POWER CYCLE required, reboot cannot clear a DS2482" : "");
 	psDS248X->ErrLogTick = now;
 	psDS248X->PrvResetOK = (u32_t)ResetOK;
@@ -237,6 +257,8 @@ void ds248xLogCRC(u8_t DevNum, u8_t PhyBus) {
 }
 #endif
 
+u16_t ds248xChanErrors(u8_t DevNum, u8_t PhyBus) { return psaDS248X[DevNum].ErrSupp[PhyBus]; }
+
 /**
  * @brief	Monitor resuts from register changes to check for consistency
  * @param[in]	psDS248X pointer to device structure
@@ -344,6 +366,27 @@ err_exit:
 	return 0;
 }
 
+#if (ds248xTRACE > 0)
+static void ds248xTracePut(ds248x_t * psDS248X, u8_t * pTxBuf, size_t TxSize, u8_t Rptr, int iRV, u32_t Tstart) {
+	u8_t Dev = psDS248X - psaDS248X;
+	if ((sTrcCtl.DevMask & (1 << Dev)) == 0 || (sTrcCtl.ChanMask & (1 << psDS248X->CurChan)) == 0 ||
+		(sTrcCtl.Cmd && sTrcCtl.Cmd != pTxBuf[0]))
+		return;
+	u32_t Dur = (u32_t) halTIMER_ReadRunTime() - Tstart;
+	u32_t Seq = __atomic_fetch_add(&TrcHead, 1, __ATOMIC_RELAXED);
+	sTrc[Seq & (ds248xTRACE_SIZE - 1)] = (ds248xtrc_t) {
+		.Tstart = Tstart, .Dur = (Dur > 0xFFFF) ? 0xFFFF : Dur, .Seq = Seq,
+		.Dev = Dev, .Chan = psDS248X->CurChan, .Cmd = pTxBuf[0],
+		.Tx = { (TxSize > 1) ? pTxBuf[1] : 0, (TxSize > 2) ? pTxBuf[2] : 0 },
+		.Rx = { psDS248X->RegX[Rptr], (Rptr == ds248xREG_PADJ) ? psDS248X->RegX[Rptr+1] : 0 },
+		.TxSize = TxSize, .Rptr = Rptr,
+		/* esp_err_t codes are positive and large, the internal er### negative and small: keep
+		 * the sign and clamp the magnitude, only "failed and how broadly" matters here */
+		.iRV = (iRV == erSUCCESS) ? 0 : (iRV < -127) ? -127 : (iRV > 127) ? 127 : iRV,
+	};
+}
+#endif
+
 /**
  * @brief
  * @param
@@ -362,9 +405,22 @@ static int ds248xWriteDelayRead(ds248x_t * psDS248X, u8_t * pTxBuf, size_t TxSiz
 	 * the 5-byte PADJ length, writing 4 bytes past that member and over the neighbouring register
 	 * mirrors. Rptr is a shared 3-bit field with no lock; the two reads must at least agree. */
 	u8_t Rptr = psDS248X->Rptr;
+#if (ds248xTRACE > 0)
+	bool bTrc = sTrcCtl.Ena;							// sampled once, an enable mid-transfer waits
+	u32_t Tstart = bTrc ? (u32_t) halTIMER_ReadRunTime() : 0;
+#endif
+#if (ds248xSIMULATE > 0)
+	int iRV = ds248xSimXfer(psDS248X->psI2C, pTxBuf, TxSize, &psDS248X->RegX[Rptr],
+		Rptr == ds248xREG_PADJ ? SO_MEM(ds248x_t, Rpadj) : 1);
+#else
 	int iRV = halI2C_Queue(psDS248X->psI2C, i2cWDR_B, pTxBuf, TxSize, &psDS248X->RegX[Rptr],
 		Rptr == ds248xREG_PADJ ? SO_MEM(ds248x_t, Rpadj) : 1, (i2cq_p1_t) uSdly, (i2cq_p2_t) NULL);
+#endif
 //	IF_SYSTIMER_STOP(debugTIMING, stDS248x);
+#if (ds248xTRACE > 0)
+	if (bTrc)
+		ds248xTracePut(psDS248X, pTxBuf, TxSize, Rptr, iRV, Tstart);
+#endif
 	if (iRV != erSUCCESS && psDS248X->psI2C->Test == 0) {
 		/* Transport failure: previously INVISIBLE at this layer (CheckRead never runs when the
 		 * transfer fails), so a fully dead bus produced no ds248x-side line at all. Counted here,
@@ -578,10 +634,9 @@ int	ds248xConfig(i2c_di_t * psI2C) {
 		return erINV_STATE;
 	if (psaDS248X == NULL) {
 		IF_myASSERT(debugPARAM, psI2C->DevIdx == 0);
-		psaDS248X = malloc(ds248xCount * sizeof(ds248x_t));
+		psaDS248X = pvOWP_ArenaAlloc(ds248xCount * sizeof(ds248x_t));
 		if (psaDS248X == NULL)
 			return erNO_MEM;
-		memset(psaDS248X, 0, ds248xCount * sizeof(ds248x_t));
 //		IF_SYSTIMER_INIT(debugTIMING, stDS248x, stMICROS, "DS248x", 300, 18000)
 	}
 	ds248x_t * psDS248X = &psaDS248X[psI2C->DevIdx];
@@ -648,10 +703,53 @@ exit:
 
 // ################################## DS248x-x00 1-Wire functions ##################################
 
-int	ds248xBusSelect(ds248x_t * psDS248X, u8_t Bus) {
+#if (ds248xLOCK == ds248xLOCK_BUS)
+static int ds248xBusWanted(ds248x_t * psDS248X, u8_t Pri) {
+	for (int p = Pri + 1; p < owPRI_NUM; ++p) {
+		if (__atomic_load_n(&psDS248X->Want[p], __ATOMIC_RELAXED))
+			return 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief	Take the bus lock, deferring to any waiter of a HIGHER class
+ * @note	The mutex alone orders waiters by TASK priority: an iButton poll waited behind a
+ *			DS18x20 read chain or enumeration of another channel on the same device.
+ * @note	A taker that backs off blocks on the device event group until a taker of a class above
+ *			BACKGROUND got the lock. The bit is only cleared and set with the lock held, so a
+ *			hand over between the back off and the wait cannot be missed.
+ */
+static void ds248xBusTake(ds248x_t * psDS248X, u8_t Pri) {
+	IF_myASSERT(debugPARAM, Pri < owPRI_NUM);
+	if (Pri >= owPRI_NUM)								// Pri:2 can hold 3, never index past Want[]
+		Pri = owPRI_NUM - 1;
+	__atomic_add_fetch(&psDS248X->Want[Pri], 1, __ATOMIC_RELAXED);
+	while (1) {
+		xRtosSemaphoreTake(&psDS248X->mux, portMAX_DELAY);
+		if (ds248xBusWanted(psDS248X, Pri) == 0)
+			break;
+		if (psDS248X->eg == NULL)
+			psDS248X->eg = xEventGroupCreate();
+		EventGroupHandle_t eg = psDS248X->eg;
+		if (eg)
+			xEventGroupClearBits(eg, ds248xEG_TAKEN);
+		xRtosSemaphoreGive(&psDS248X->mux);			// higher class waiting, let it in first
+		if (eg)
+			xEventGroupWaitBits(eg, ds248xEG_TAKEN, pdFALSE, pdTRUE, portMAX_DELAY);
+		else
+			vTaskDelay(1);								// no memory for the event group, poll
+	}
+	__atomic_sub_fetch(&psDS248X->Want[Pri], 1, __ATOMIC_RELAXED);
+	if (Pri > owPRI_BACKGROUND && psDS248X->eg)		// lower classes may be backing off for us
+		xEventGroupSetBits(psDS248X->eg, ds248xEG_TAKEN);
+}
+#endif
+
+int	ds248xBusSelect(ds248x_t * psDS248X, u8_t Bus, u8_t Pri) {
 	int iRV = 1;
 	#if (ds248xLOCK == ds248xLOCK_BUS)
-		xRtosSemaphoreTake(&psDS248X->mux, portMAX_DELAY);
+		ds248xBusTake(psDS248X, Pri);
 		/* Recovery that was skipped because WE (or a predecessor) held the lock mid-transaction.
 		 * Run it now, BEFORE the channel select: ds248xConfig's DRST resets CurChan to 0, so the
 		 * select below then proceeds from known-good state. The owner-aware take inside
@@ -692,6 +790,19 @@ void ds248xBusRelease(ds248x_t * psDS248X) {
 	#endif
 }
 
+int	ds248xBusYield(ds248x_t * psDS248X, u8_t Bus, u8_t Pri) {
+	#if (ds248xLOCK == ds248xLOCK_BUS)
+		if (ds248xBusWanted(psDS248X, Pri)) {
+			ds248xBusRelease(psDS248X);
+			int iRV = ds248xBusSelect(psDS248X, Bus, Pri);	// channel re-selected if changed meanwhile
+			if (iRV != 1)								// select failure released the lock, retake
+				ds248xBusTake(psDS248X, Pri);			// to keep the caller's Select/Release pairing
+			return iRV;
+		}
+	#endif
+	return 1;
+}
+
 int	ds248xOWReset(ds248x_t * psDS248X) {
 	// DS2482-800 datasheet page 7 para 2
 	if (psDS248X->CfgSet.SPU == owPOWER_STRONG)			// INTENT, not the mirror: a clobbered mirror
@@ -784,6 +895,33 @@ u8_t ds248xOWSearchTriplet(ds248x_t * psDS248X, u8_t u8Dir) {
 	return psDS248X->Rstat;
 }
 
+// ###################################### 1-Wire backend ops ########################################
+
+static int ds248xOpsSelect(u8_t DevNum, u8_t Bus, u8_t Pri) { return ds248xBusSelect(&psaDS248X[DevNum], Bus, Pri); }
+static int ds248xOpsYield(u8_t DevNum, u8_t Bus, u8_t Pri) { return ds248xBusYield(&psaDS248X[DevNum], Bus, Pri); }
+static void ds248xOpsRelease(u8_t DevNum) { ds248xBusRelease(&psaDS248X[DevNum]); }
+static int ds248xOpsReset(u8_t DevNum) { return ds248xOWReset(&psaDS248X[DevNum]); }
+static bool ds248xOpsTouchBit(u8_t DevNum, bool Bit) { return ds248xOWTouchBit(&psaDS248X[DevNum], Bit); }
+static u8_t ds248xOpsWriteByte(u8_t DevNum, u8_t Byte) { return ds248xOWWriteByte(&psaDS248X[DevNum], Byte); }
+static u8_t ds248xOpsReadByte(u8_t DevNum) { return ds248xOWReadByte(&psaDS248X[DevNum]); }
+static int ds248xOpsSpeed(u8_t DevNum, bool Spd) { return ds248xOWSpeed(&psaDS248X[DevNum], Spd); }
+static int ds248xOpsLevel(u8_t DevNum, bool Pwr) { return ds248xOWLevel(&psaDS248X[DevNum], Pwr); }
+
+static u8_t ds248xOpsTriplet(u8_t DevNum, u8_t Dir) {
+	u8_t Stat = ds248xOWSearchTriplet(&psaDS248X[DevNum], Dir);
+	return ((Stat & ds248xSTAT_SBR) ? owTRIP_ID : 0) |
+		   ((Stat & ds248xSTAT_TSB) ? owTRIP_CMP : 0) |
+		   ((Stat & ds248xSTAT_DIR) ? owTRIP_DIR : 0);
+}
+
+const ow_ops_t ds248xOps = {
+	.Select = ds248xOpsSelect,		.Yield = ds248xOpsYield,		.Release = ds248xOpsRelease,
+	.Reset = ds248xOpsReset,		.TouchBit = ds248xOpsTouchBit,
+	.WriteByte = ds248xOpsWriteByte,	.ReadByte = ds248xOpsReadByte,
+	.Triplet = ds248xOpsTriplet,	.Speed = ds248xOpsSpeed,		.Level = ds248xOpsLevel,
+	.Caps = owCAP_TRIPLET | owCAP_OVERDRIVE | owCAP_STRONG_PU,
+};
+
 // #################################### DS248x debug/reporting #####################################
 
 #if (ds248xCHAN_ATTRIB > 0)
@@ -795,7 +933,7 @@ void ds248xAuditRun(void) {
 		psDS248X->AuditPend = 0;
 		u8_t SEL = 0, LL = 0, SD = 0, PPD = 0;			// bit N = channel N
 		for (u8_t Ch = 0; Ch < 8; ++Ch) {
-			if (ds248xBusSelect(psDS248X, Ch) != 1)
+			if (ds248xBusSelect(psDS248X, Ch, owPRI_BACKGROUND) != 1)
 				continue;								// select failed: absent from SEL map
 			SEL |= (1 << Ch);
 			if (ds248xReadRegister(psDS248X, ds248xREG_STAT) == 1 && psDS248X->LL)
@@ -906,12 +1044,86 @@ int ds248xReport(report_t * psR, ds248x_t * psDS248X) {
 	#if (HAL_DS18X20 > 0)
 		iRV += xRtosReportTimer(psR, psDS248X->th);
 	#endif
+	#if (ds248xSIMULATE > 0)
+		iRV += ds248xSimReport(psR, psDS248X->psI2C->DevIdx);
+	#endif
+	return iRV;
+}
+
+void ds248xSnapshot(owsnap_wr_t * psW) {
+	owsnap_chip_t * psC = pvOWP_SnapSection(psW, owsnapSEC_CHIP, sizeof(owsnap_chip_t), ds248xCount);
+	for (int i = 0; psC && i < ds248xCount; ++i) {
+		ds248x_t * psDS248X = &psaDS248X[i];
+		psC[i] = (owsnap_chip_t) { .Type = psDS248X->psI2C->Type, .State = psDS248X->State,
+			.WedgeCnt = psDS248X->WedgeCnt, .Lo = psDS248X->Lo, .XErr = psDS248X->XErrCnt,
+			.Skip = psDS248X->SkipCnt, .Bkof = psDS248X->BkofCnt };
+		memcpy(psC[i].Err, psDS248X->ErrSupp, sizeof(psC[i].Err));
+	}
+	#if (ds248xSTAT_DEBUG > 0)
+	owsnap_act_t * psA = pvOWP_SnapSection(psW, owsnapSEC_ACT, sizeof(owsnap_act_t), ds248xCount * 8);
+	for (int i = 0; psA && i < ds248xCount; ++i) {
+		ds248x_t * psDS248X = &psaDS248X[i];
+		for (int Ch = 0; Ch < 8; ++Ch)
+			*psA++ = (owsnap_act_t) { .Rst = psDS248X->RstCnt[Ch], .PPD = psDS248X->PPDcnt[Ch],
+				.Trip = psDS248X->TripCnt[Ch], .Tag = psDS248X->TagCnt[Ch] };
+	}
+	#endif
+}
+
+#if (ds248xTRACE > 0)
+void ds248xTraceCtrl(u8_t Flags, u8_t DevMask, u8_t ChanMask, u8_t Cmd) {
+	sTrcCtl.Ena = 0;									// stop before touching filters or ring
+	sTrcCtl.Freeze = (Flags & ds248xTRC_FREEZE) ? 1 : 0;
+	sTrcCtl.DevMask = DevMask;
+	sTrcCtl.ChanMask = ChanMask;
+	sTrcCtl.Cmd = Cmd;
+	if (Flags & ds248xTRC_ENA) {
+		__atomic_store_n(&TrcHead, 0, __ATOMIC_SEQ_CST);
+		memset(sTrc, 0, sizeof(sTrc));
+		sTrcCtl.Ena = 1;
+	}
+}
+
+int	ds248xTraceGet(ds248xtrc_t * psTrc, int Max) {
+	u32_t Head = __atomic_load_n(&TrcHead, __ATOMIC_SEQ_CST);
+	u32_t Tail = (Head > ds248xTRACE_SIZE) ? Head - ds248xTRACE_SIZE : 0;
+	if ((Head - Tail) > Max)
+		Tail = Head - Max;
+	int Num = 0;
+	while (Tail != Head)
+		psTrc[Num++] = sTrc[Tail++ & (ds248xTRACE_SIZE - 1)];
+	return Num;
+}
+
+int	ds248xTraceReport(report_t * psR) {
+	int iRV = xReport(psR, "Trace %s  Dev=x%02X Ch=x%02X Cmd=x%02X  #=%lu\r\n",
+		sTrcCtl.Ena ? "on" : sTrcCtl.Freeze ? "frozen/off" : "off", sTrcCtl.DevMask,
+		sTrcCtl.ChanMask, sTrcCtl.Cmd, TrcHead);
+	ds248xtrc_t sRec;
+	u32_t Head = __atomic_load_n(&TrcHead, __ATOMIC_SEQ_CST), Prev = 0;
+	for (u32_t Tail = (Head > ds248xTRACE_SIZE) ? Head - ds248xTRACE_SIZE : 0; Tail != Head; ++Tail) {
+		sRec = sTrc[Tail & (ds248xTRACE_SIZE - 1)];
+		iRV += xReport(psR, "%5u +%8luuS D%u/C%u x%02X", sRec.Seq, Prev ? sRec.Tstart - Prev : 0,
+			sRec.Dev, sRec.Chan, sRec.Cmd);
+		if (sRec.TxSize > 1)
+			iRV += xReport(psR, (sRec.TxSize > 2) ? " x%02X x%02X" : " x%02X    ", sRec.Tx[0], sRec.Tx[1]);
+		else
+			iRV += xReport(psR, "        ");
+		iRV += xReport(psR, "  %s=x%02X  %4uuS  %d\r\n", RegNames[sRec.Rptr < ds248xREG_NUM ? sRec.Rptr : 0],
+			sRec.Rx[0], sRec.Dur, sRec.iRV);
+		Prev = sRec.Tstart;
+	}
 	return iRV;
 }
+#endif
 
 int ds248xReportAll(report_t * psR) {
 	int iRV = 0;
 	for (int i = 0; i < ds248xCount; iRV += ds248xReport(psR, &psaDS248X[i++]));
+	#if (ds248xTRACE > 0)
+	if (TrcHead)										// only once something was captured
+		iRV += ds248xTraceReport(psR);
+	#endif
 	return iRV;
 }
 
@@ -0,0 +1,554 @@
+/*
+ * ds248xsim.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Virtual DS2482-10x/-800/DS2484 with a population of DS18x20/DS1990 devices per channel.
+ * Replaces the single I2C boundary (halI2C_Queue in ds248xWriteDelayRead) so the complete
+ * onewire/ds248x/ds18x20/ds1990x stack runs unchanged, without hardware. Every transaction is
+ * costed (I2C bytes at 400KHz plus the 1-Wire operation) so scan & sense cycles can be compared
+ * from one build to the next in simulated time and transaction counts.
+ * With ds248xTRACE a field capture (ds248xTraceGet) can be replayed instead of the model, so new
+ * driver code is checked against real populations and error patterns, see ds248xSimReplay().
+ */
+
+#include "hal_platform.h"
+
+#if (HAL_DS248X > 0) && (ds248xSIMULATE > 0)
+#include "hal_i2c_common.h"
+#include "onewire_platform.h"
+#include "report.h"
+#include "syslog.h"
+#include "errors_events.h"
+
+#include <string.h>
+
+// ###################################### General macros ###########################################
+
+#define	debugFLAG					0xF000
+
+#define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
+#define	debugTRACK					(debugFLAG_GLOBAL & debugFLAG & 0x2000)
+#define	debugPARAM					(debugFLAG_GLOBAL & debugFLAG & 0x4000)
+#define	debugRESULT					(debugFLAG_GLOBAL & debugFLAG & 0x8000)
+
+// ######################################## Build macros ###########################################
+
+#ifndef ds248xSIM_TYPE
+	#define	ds248xSIM_TYPE			i2cDEV_DS2482_800	// model of EVERY simulated device
+#endif
+
+#ifndef ds248xSIM_DS18B20
+	#define	ds248xSIM_DS18B20		2				// virtual DS18B20 per channel at boot
+#endif
+
+#ifndef ds248xSIM_DS18S20
+	#define	ds248xSIM_DS18S20		0				// virtual DS18S20 per channel at boot
+#endif
+
+#ifndef ds248xSIM_DS1990
+	#define	ds248xSIM_DS1990		0				// virtual DS1990 per channel at boot, see ds248xSimAttach()
+#endif
+
+#define	ds248xSIM_NUM				4				// simulated DS248x, DevNum is 2 bits
+#define	ds248xSIM_MAX_DEV			8				// virtual 1-Wire devices per channel
+#define	ds248xSIM_I2C_BYTE			22500			// nSec, 9 bits @ 400KHz
+
+// ##################################### Local structures ##########################################
+
+enum { simROMCMD, simMATCH, simREADROM, simSEARCH, simFUNC, simTX, simRX, simIDLE };
+
+typedef struct ds248xsim_dev_t {		// virtual 1-Wire slave
+	u64_t ROM;							// 0 = unused slot
+	u8_t SP[9];							// DS18x20 scratchpad
+	u8_t Buf[9];						// bytes being sent/received in simTX/simRX
+	u8_t Len;							// bytes in Buf
+	u8_t Phase;							// sim? state
+	u8_t Cnt;							// bit counter in current phase
+	u8_t Shift;							// command byte being assembled
+	u8_t Act;							// selected, participating in the current transaction
+	u8_t Seq;							// conversions done, drives the temperature model
+} ds248xsim_dev_t;
+
+typedef struct ds248xsim_t {			// virtual DS248x
+	struct i2c_di_t * psI2C;			// key, NULL = unused
+	ds248xsim_stat_t sStat;
+	ds248xsim_dev_t Dev[8][ds248xSIM_MAX_DEV];
+	u8_t Rptr, Stat, Data, Chan, Conf;
+} ds248xsim_t;
+
+// ###################################### Local variables ##########################################
+
+static ds248xsim_t sSim[ds248xSIM_NUM];
+static const u8_t ChanWr[8] = { 0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87 };	// CHSL codes
+static const u8_t ChanRd[8] = { 0xB8, 0xB1, 0xAA, 0xA3, 0x9C, 0x95, 0x8E, 0x87 };	// CHAN read back codes
+static TaskHandle_t hOwner = NULL;						// only its transfers counted, NULL = all
+static const u8_t Padj[5] = { 0x06, 0x26, 0x46, 0x66, 0x86 };	// DS2484 defaults, PAR = 0 -> 4
+
+#if (ds248xTRACE > 0)
+static const ds248xtrc_t * psScript = NULL;
+static u32_t ScriptIdx[ds248xSIM_NUM];					// next record to scan from, per device
+static ds248xsim_replay_t sReplay;
+#endif
+
+// ################################# Virtual 1-Wire slave model ####################################
+
+static u8_t ds248xSimFamily(ds248xsim_dev_t * psDev) { return psDev->ROM & 0xFF; }
+
+static void ds248xSimSetCRC(u8_t * pBuf, int Len) { pBuf[Len] = OWCalcCRC8(pBuf, Len); }
+
+/**
+ * @brief	Generate a ROM with valid CRC, unique per simulated device/channel/index
+ */
+static u64_t ds248xSimROM(u8_t Family, int DevIdx, int Chan, int Idx) {
+	ow_rom_t sROM = { .FAM = Family, .TAG = { Idx, Chan, DevIdx, 0x5A, 0xA5, 0x00 } };
+	sROM.CRC = OWCalcCRC8(sROM.HexChars, 7);
+	return sROM.Value;
+}
+
+static void ds248xSimInitSP(ds248xsim_dev_t * psDev) {
+	static const u8_t SP28[8] = { 0x90, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10 };	// 25C, 12bit
+	static const u8_t SP10[8] = { 0x32, 0x00, 0x4B, 0x46, 0xFF, 0xFF, 0x0C, 0x10 };	// 25C
+	memcpy(psDev->SP, (ds248xSimFamily(psDev) == OWFAMILY_28) ? SP28 : SP10, 8);
+	ds248xSimSetCRC(psDev->SP, 8);
+}
+
+/**
+ * @brief	Temperature model: slow deterministic drift, every 4th conversion steps 1 LSB
+ */
+static void ds248xSimConvert(ds248xsim_dev_t * psDev) {
+	i16_t Raw = psDev->SP[0] | (psDev->SP[1] << 8);
+	if ((++psDev->Seq & 0x03) == 0)
+		++Raw;
+	psDev->SP[0] = Raw & 0xFF;
+	psDev->SP[1] = Raw >> 8;
+	ds248xSimSetCRC(psDev->SP, 8);
+}
+
+static void ds248xSimFunction(ds248xsim_dev_t * psDev, u8_t Cmd) {
+	psDev->Cnt = 0;
+	psDev->Phase = simIDLE;
+	if (ds248xSimFamily(psDev) == OWFAMILY_01) {	// ROM only device
+		psDev->Act = 0;
+		return;
+	}
+	switch (Cmd) {
+	case DS18X20_READ_SP:
+		memcpy(psDev->Buf, psDev->SP, 9);
+		psDev->Len = 9;
+		psDev->Phase = simTX;
+		break;
+	case DS18X20_WRITE_SP:							// TH & TL, DS18B20 adds the config register
+		psDev->Len = (ds248xSimFamily(psDev) == OWFAMILY_28) ? 3 : 2;
+		psDev->Phase = simRX;
+		break;
+	case DS18X20_READ_PSU:
+		psDev->Buf[0] = 0xFF;						// externally powered
+		psDev->Len = 1;
+		psDev->Phase = simTX;
+		break;
+	case DS18X20_CONVERT:
+		ds248xSimConvert(psDev);
+		break;
+	case DS18X20_COPY_SP:
+	case DS18X20_RECALL_EE:
+		break;
+	default:
+		psDev->Act = 0;
+	}
+}
+
+static bool ds248xSimOut(ds248xsim_dev_t * psDev) {
+	switch (psDev->Phase) {
+	case simREADROM:
+		return (psDev->ROM >> psDev->Cnt) & 1;
+	case simSEARCH: {
+		bool Bit = (psDev->ROM >> (psDev->Cnt / 3)) & 1;
+		return (psDev->Cnt % 3) == 0 ? Bit : (psDev->Cnt % 3) == 1 ? !Bit : 1;
+	}
+	case simTX:
+		return (psDev->Cnt < psDev->Len * 8) ? (psDev->Buf[psDev->Cnt / 8] >> (psDev->Cnt % 8)) & 1 : 1;
+	default:
+		return 1;									// not driving
+	}
+}
+
+static void ds248xSimIn(ds248xsim_dev_t * psDev, bool Line) {
+	switch (psDev->Phase) {
+	case simROMCMD:
+	case simFUNC:
+		psDev->Shift |= Line << psDev->Cnt;
+		if (++psDev->Cnt < 8)
+			break;
+		u8_t Cmd = psDev->Shift;
+		psDev->Shift = psDev->Cnt = 0;
+		if (psDev->Phase == simFUNC) {
+			ds248xSimFunction(psDev, Cmd);
+		} else if (Cmd == OW_CMD_MATCHROM) {
+			psDev->Phase = simMATCH;
+		} else if (Cmd == OW_CMD_SKIPROM) {
+			psDev->Phase = simFUNC;
+		} else if (Cmd == OW_CMD_READROM) {
+			psDev->Phase = simREADROM;
+		} else if (Cmd == OW_CMD_SEARCHROM) {
+			psDev->Phase = simSEARCH;
+		} else {									// alarm search included, never in alarm
+			psDev->Act = 0;
+		}
+		break;
+	case simMATCH:
+		if (Line != ((psDev->ROM >> psDev->Cnt) & 1))
+			psDev->Act = 0;
+		if (++psDev->Cnt == 64) {
+			psDev->Cnt = 0;
+			psDev->Phase = simFUNC;
+		}
+		break;
+	case simREADROM:
+		if (++psDev->Cnt == 64) {
+			psDev->Cnt = 0;
+			psDev->Phase = simFUNC;
+		}
+		break;
+	case simSEARCH:
+		if ((psDev->Cnt % 3) == 2 && Line != ((psDev->ROM >> (psDev->Cnt / 3)) & 1))
+			psDev->Act = 0;
+		if (++psDev->Cnt == 192) {
+			psDev->Cnt = 0;
+			psDev->Phase = simFUNC;
+		}
+		break;
+	case simTX:
+		++psDev->Cnt;
+		break;
+	case simRX:
+		if (Line)
+			psDev->Buf[psDev->Cnt / 8] |= 1 << (psDev->Cnt % 8);
+		else
+			psDev->Buf[psDev->Cnt / 8] &= ~(1 << (psDev->Cnt % 8));
+		if (++psDev->Cnt == psDev->Len * 8) {
+			memcpy(&psDev->SP[2], psDev->Buf, psDev->Len);
+			ds248xSimSetCRC(psDev->SP, 8);
+			psDev->Phase = simIDLE;
+		}
+		break;
+	}
+}
+
+/**
+ * @brief	One time slot, the line is the wired-AND of master and all participating devices
+ */
+static bool ds248xSimSlot(ds248xsim_t * psSim, bool Wr) {
+	ds248xsim_dev_t * psDev = psSim->Dev[psSim->Chan];
+	bool Line = Wr;
+	for (int i = 0; i < ds248xSIM_MAX_DEV; ++i) {
+		if (psDev[i].ROM && psDev[i].Act)
+			Line &= ds248xSimOut(&psDev[i]);
+	}
+	for (int i = 0; i < ds248xSIM_MAX_DEV; ++i) {
+		if (psDev[i].ROM && psDev[i].Act)
+			ds248xSimIn(&psDev[i], Line);
+	}
+	++psSim->sStat.Slots;
+	return Line;
+}
+
+static bool ds248xSimReset(ds248xsim_t * psSim) {
+	ds248xsim_dev_t * psDev = psSim->Dev[psSim->Chan];
+	bool Pres = 0;
+	for (int i = 0; i < ds248xSIM_MAX_DEV; ++i) {
+		if (psDev[i].ROM == 0)
+			continue;
+		psDev[i].Act = 1;
+		psDev[i].Phase = simROMCMD;
+		psDev[i].Cnt = psDev[i].Shift = 0;
+		Pres = 1;
+	}
+	++psSim->sStat.Resets;
+	return Pres;
+}
+
+static u8_t ds248xSimByte(ds248xsim_t * psSim, u8_t Byte) {
+	u8_t Res = 0;
+	for (int i = 0; i < 8; ++i)
+		Res |= ds248xSimSlot(psSim, (Byte >> i) & 1) << i;
+	return Res;
+}
+
+// ################################### Virtual DS248x device #######################################
+
+static ds248xsim_t * ds248xSimGet(struct i2c_di_t * psI2C) {
+	for (int i = 0; i < ds248xSIM_NUM; ++i) {
+		if (sSim[i].psI2C == psI2C)
+			return &sSim[i];
+		if (sSim[i].psI2C)
+			continue;
+		ds248xsim_t * psSim = &sSim[i];				// first use, populate
+		psSim->psI2C = psI2C;
+		int NumChan = (ds248xSIM_TYPE == i2cDEV_DS2482_800) ? 8 : 1;
+		for (int Ch = 0; Ch < NumChan; ++Ch) {
+			int Idx = 0;
+			for (int n = 0; n < ds248xSIM_DS18B20 && Idx < ds248xSIM_MAX_DEV; ++n, ++Idx)
+				psSim->Dev[Ch][Idx].ROM = ds248xSimROM(OWFAMILY_28, i, Ch, Idx);
+			for (int n = 0; n < ds248xSIM_DS18S20 && Idx < ds248xSIM_MAX_DEV; ++n, ++Idx)
+				psSim->Dev[Ch][Idx].ROM = ds248xSimROM(OWFAMILY_10, i, Ch, Idx);
+			for (int n = 0; n < ds248xSIM_DS1990 && Idx < ds248xSIM_MAX_DEV; ++n, ++Idx)
+				psSim->Dev[Ch][Idx].ROM = ds248xSimROM(OWFAMILY_01, i, Ch, Idx);
+			for (int n = 0; n < Idx; ++n)
+				ds248xSimInitSP(&psSim->Dev[Ch][n]);
+		}
+		return psSim;
+	}
+	return NULL;
+}
+
+/**
+ * @brief	Register pointer codes are the register number in the low nibble, inverted in the high
+ */
+static bool ds248xSimCode(u8_t Code) { return ((Code >> 4) ^ (Code & 0x0F)) == 0x0F; }
+
+/**
+ * @brief	Map a CHSL code to the channel selected
+ * @return	channel (0->7) or -1 if Code is not one of the 8 valid codes
+ */
+static int ds248xSimChan(u8_t Code) {
+	for (int Chan = 0; Chan < sizeof(ChanWr); ++Chan) {
+		if (ChanWr[Chan] == Code)
+			return Chan;
+	}
+	return -1;
+}
+
+#if (ds248xTRACE > 0)
+/**
+ * @brief	Answer a transfer from the replay script instead of the model
+ */
+static int ds248xSimScript(ds248xsim_t * psSim, u8_t * pTxBuf, size_t TxSize, u8_t * pRxBuf, size_t RxSize) {
+	u8_t Dev = psSim - sSim;
+	u32_t Idx = ScriptIdx[Dev];
+	while (Idx < sReplay.Num && psScript[Idx].Dev != Dev)
+		++Idx;											// records of other devices are consumed by them
+	if (Idx >= sReplay.Num) {
+		++sReplay.Extra;
+		return erFAILURE;
+	}
+	const ds248xtrc_t * psRec = &psScript[Idx];
+	ScriptIdx[Dev] = Idx + 1;
+	++sReplay.Used;
+	u8_t Tx1 = (TxSize > 1) ? pTxBuf[1] : 0, Tx2 = (TxSize > 2) ? pTxBuf[2] : 0;
+	// the read pointer follows from the command sequence, a change there shows up as Cmd/Tx
+	if (psRec->Cmd != pTxBuf[0] || psRec->TxSize != TxSize || psRec->Tx[0] != Tx1 || psRec->Tx[1] != Tx2) {
+		if (sReplay.Diverge++ == 0)
+			sReplay.First = Idx;
+	}
+	pRxBuf[0] = psRec->Rx[0];
+	if (RxSize > 1)
+		pRxBuf[1] = psRec->Rx[1];
+	sReplay.Tbus += (u64_t) psRec->Dur * 1000ULL;
+	psSim->sStat.Tbus += (u64_t) psRec->Dur * 1000ULL;
+	return (psRec->iRV == 0) ? erSUCCESS : psRec->iRV;
+}
+#endif
+
+static int ds248xSimModel(ds248xsim_t * psSim, u8_t * pTxBuf, size_t TxSize, u8_t * pRxBuf, size_t RxSize) {
+	++psSim->sStat.Xfers;
+	#if (ds248xTRACE > 0)
+	if (psScript)
+		return ds248xSimScript(psSim, pTxBuf, TxSize, pRxBuf, RxSize);
+	#endif
+	bool OD = psSim->Conf & 0x08;
+	u32_t Tow = 0;									// 1-Wire time (uSec)
+	psSim->sStat.Tbus += (u64_t) (2 + TxSize + RxSize) * ds248xSIM_I2C_BYTE;
+	switch (pTxBuf[0]) {
+	case ds248xCMD_DRST:
+		psSim->Stat = ds248xSTAT_RST | ds248xSTAT_LL;
+		psSim->Conf = psSim->Chan = 0;
+		psSim->Rptr = ds248xREG_STAT;
+		break;
+	case ds248xCMD_SRP: {
+		u8_t Reg = pTxBuf[1] & 0x0F;
+		if (ds248xSimCode(pTxBuf[1]) == 0 || Reg >= ds248xREG_NUM ||
+			(Reg == ds248xREG_CHAN && ds248xSIM_TYPE != i2cDEV_DS2482_800) ||
+			(Reg == ds248xREG_PADJ && ds248xSIM_TYPE != i2cDEV_DS2484))
+			return erFAILURE;						// NACK
+		psSim->Rptr = Reg;
+		break;
+	}
+	case ds248xCMD_WCFG:
+		if (ds248xSimCode(pTxBuf[1]) == 0)
+			return erFAILURE;
+		psSim->Conf = pTxBuf[1] & 0x0F;
+		psSim->Stat &= ~ds248xSTAT_RST;
+		psSim->Rptr = ds248xREG_CONF;
+		break;
+	case ds2482CMD_CHSL: {							// == ds2484CMD_PADJ
+		int Chan = ds248xSimChan(pTxBuf[1]);
+		if (ds248xSIM_TYPE == i2cDEV_DS2484) {
+			psSim->Rptr = ds248xREG_PADJ;			// adjustments accepted, not modelled
+		} else if (ds248xSIM_TYPE == i2cDEV_DS2482_800 && Chan >= 0) {
+			psSim->Chan = Chan;
+			psSim->Rptr = ds248xREG_CHAN;
+		} else {
+			return erFAILURE;						// invalid channel code, NACK
+		}
+		break;
+	}
+	case ds248xCMD_1WRS:
+		psSim->Conf &= ~0x04;						// SPU ends
+		psSim->Stat = ds248xSTAT_LL | (ds248xSimReset(psSim) ? ds248xSTAT_PPD : 0);
+		psSim->Rptr = ds248xREG_STAT;
+		Tow = OD ? owDELAY_RST_OD : owDELAY_RST;
+		break;
+	case ds248xCMD_1WWB:
+		ds248xSimByte(psSim, pTxBuf[1]);
+		psSim->Stat = ds248xSTAT_LL;
+		psSim->Rptr = ds248xREG_STAT;
+		Tow = OD ? owDELAY_WB_OD : owDELAY_WB;
+		break;
+	case ds248xCMD_1WRB:
+		psSim->Data = ds248xSimByte(psSim, 0xFF);
+		psSim->Stat = ds248xSTAT_LL;
+		psSim->Rptr = ds248xREG_STAT;
+		Tow = OD ? owDELAY_RB_OD : owDELAY_RB;
+		break;
+	case ds248xCMD_1WSB:
+		psSim->Stat = ds248xSTAT_LL | (ds248xSimSlot(psSim, pTxBuf[1] & 0x80) ? ds248xSTAT_SBR : 0);
+		psSim->Rptr = ds248xREG_STAT;
+		Tow = OD ? owDELAY_SB_OD : owDELAY_SB;
+		break;
+	case ds248xCMD_1WT: {
+		bool Id = ds248xSimSlot(psSim, 1), Cmp = ds248xSimSlot(psSim, 1);
+		bool Dir = (Id == Cmp) ? (Id || (pTxBuf[1] & 0x80)) : Id;
+		ds248xSimSlot(psSim, Dir);
+		psSim->Stat = ds248xSTAT_LL | (Id ? ds248xSTAT_SBR : 0) | (Cmp ? ds248xSTAT_TSB : 0) | (Dir ? ds248xSTAT_DIR : 0);
+		psSim->Rptr = ds248xREG_STAT;
+		Tow = OD ? owDELAY_ST_OD : owDELAY_ST;
+		break;
+	}
+	default:
+		return erFAILURE;
+	}
+	psSim->sStat.Tbus += (u64_t) Tow * 1000ULL;
+	switch (psSim->Rptr) {
+	case ds248xREG_STAT:	pRxBuf[0] = psSim->Stat;	break;
+	case ds248xREG_DATA:	pRxBuf[0] = psSim->Data;	break;
+	case ds248xREG_CHAN:	pRxBuf[0] = ChanRd[psSim->Chan];	break;
+	case ds248xREG_CONF:	pRxBuf[0] = psSim->Conf;	break;
+	case ds248xREG_PADJ:	memcpy(pRxBuf, Padj, RxSize < sizeof(Padj) ? RxSize : sizeof(Padj));	break;
+	}
+	return erSUCCESS;
+}
+
+/**
+ * @brief	Task the transfer is done for, parallel scan workers act for the task that started it
+ */
+static TaskHandle_t ds248xSimTask(void) {
+	#if (onewirePAR_SCAN > 0)
+	return OWP_ScanOwner();
+	#else
+	return xTaskGetCurrentTaskHandle();
+	#endif
+}
+
+int	ds248xSimXfer(struct i2c_di_t * psI2C, u8_t * pTxBuf, size_t TxSize, u8_t * pRxBuf, size_t RxSize) {
+	ds248xsim_t * psSim = ds248xSimGet(psI2C);
+	if (psSim == NULL)
+		return erFAILURE;
+	if (hOwner == NULL || ds248xSimTask() == hOwner)
+		return ds248xSimModel(psSim, pTxBuf, TxSize, pRxBuf, RxSize);
+	ds248xsim_stat_t sStat = psSim->sStat;			// other tasks' traffic is not counted
+	int iRV = ds248xSimModel(psSim, pTxBuf, TxSize, pRxBuf, RxSize);
+	psSim->sStat = sStat;
+	return iRV;
+}
+
+// ###################################### Direct line access ########################################
+
+bool ds248xSimLineReset(struct i2c_di_t * psI2C, u8_t Chan) {
+	ds248xsim_t * psSim = ds248xSimGet(psI2C);
+	if (psSim == NULL || Chan > 7)
+		return 0;
+	psSim->Chan = Chan;
+	return ds248xSimReset(psSim);
+}
+
+bool ds248xSimLineSlot(struct i2c_di_t * psI2C, u8_t Chan, bool Wr) {
+	ds248xsim_t * psSim = ds248xSimGet(psI2C);
+	if (psSim == NULL || Chan > 7)
+		return 1;									// nothing pulls the line low
+	psSim->Chan = Chan;
+	return ds248xSimSlot(psSim, Wr);
+}
+
+// ##################################### Population control ########################################
+
+int	ds248xSimAttach(u8_t DevIdx, u8_t Chan, u64_t ROM) {
+	if (DevIdx >= ds248xSIM_NUM || sSim[DevIdx].psI2C == NULL || Chan > 7)
+		return erINV_INDEX;
+	ds248xsim_dev_t * psDev = sSim[DevIdx].Dev[Chan];
+	for (int i = 0; i < ds248xSIM_MAX_DEV; ++i) {
+		if (psDev[i].ROM)
+			continue;
+		memset(&psDev[i], 0, sizeof(ds248xsim_dev_t));
+		psDev[i].ROM = ROM;
+		ds248xSimInitSP(&psDev[i]);
+		return erSUCCESS;
+	}
+	return erNO_MEM;
+}
+
+int	ds248xSimDetach(u8_t DevIdx, u8_t Chan, u64_t ROM) {
+	if (DevIdx >= ds248xSIM_NUM || sSim[DevIdx].psI2C == NULL || Chan > 7)
+		return erINV_INDEX;
+	ds248xsim_dev_t * psDev = sSim[DevIdx].Dev[Chan];
+	for (int i = 0; i < ds248xSIM_MAX_DEV; ++i) {
+		if (psDev[i].ROM == ROM) {
+			psDev[i].ROM = 0;
+			return erSUCCESS;
+		}
+	}
+	return erINV_VALUE;
+}
+
+// ####################################### Statistics ##############################################
+
+void ds248xSimStats(u8_t DevIdx, ds248xsim_stat_t * psStat) {
+	IF_myASSERT(debugPARAM, DevIdx < ds248xSIM_NUM);
+	*psStat = sSim[DevIdx].sStat;
+}
+
+void ds248xSimOwner(TaskHandle_t hTask) { hOwner = hTask; }
+
+void ds248xSimClear(void) {
+	for (int i = 0; i < ds248xSIM_NUM; ++i)
+		memset(&sSim[i].sStat, 0, sizeof(ds248xsim_stat_t));
+}
+
+int	ds248xSimReport(report_t * psR, u8_t DevIdx) {
+	ds248xsim_stat_t * psStat = &sSim[DevIdx].sStat;
+	return xReport(psR, "SIM Xfer=%lu  Rst=%lu  Slots=%lu  Tbus=%lluuS\r\n", psStat->Xfers,
+		psStat->Resets, psStat->Slots, psStat->Tbus / 1000ULL);
+}
+
+#if (ds248xTRACE > 0)
+// ######################################### Trace replay ##########################################
+
+void ds248xSimReplay(const ds248xtrc_t * psTrc, int Num) {
+	memset(&sReplay, 0, sizeof(sReplay));
+	memset(ScriptIdx, 0, sizeof(ScriptIdx));
+	sReplay.Num = sReplay.First = (psTrc && Num > 0) ? Num : 0;
+	psScript = sReplay.Num ? psTrc : NULL;
+}
+
+void ds248xSimReplayResult(ds248xsim_replay_t * psRes) { *psRes = sReplay; }
+
+int	ds248xSimReplayReport(report_t * psR) {
+	u64_t Trec = 0;
+	for (int i = 0; psScript && i < sReplay.Num; Trec += psScript[i++].Dur);
+	int iRV = xReport(psR, "REPLAY Used=%lu/%lu  Div=%lu", sReplay.Used, sReplay.Num, sReplay.Diverge);
+	if (sReplay.Diverge) {
+		const ds248xtrc_t * psRec = &psScript[sReplay.First];
+		iRV += xReport(psR, " (first #%lu D%u/C%u x%02X)", sReplay.First, psRec->Dev, psRec->Chan, psRec->Cmd);
+	}
+	return iRV + xReport(psR, "  Extra=%lu  Tbus=%llu/%lluuS\r\n", sReplay.Extra, sReplay.Tbus / 1000ULL, Trec);
+}
+#endif
+#endif
@@ -0,0 +1,47 @@
+/*
+ * owbench.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host: run the OWP_Bench() scenarios on a simulated DS2482-800, CSV on stdout.
+ *	owbench [-b]
+ *	-b	run DS18x20 sense and iButton poll passes in a background task meanwhile, the counts must
+ *		not change (only the benchmark task's transfers are counted).
+ * Exit code is the number of scenarios that regressed.
+ */
+
+#include "hal_platform.h"
+#include "hal_i2c_common.h"
+#include "onewire_platform.h"
+
+#include <string.h>
+
+static volatile bool bRun = 1;
+static volatile u32_t Passes = 0;
+
+static void vBackground(void * pvPara) {
+	epw_t sEWP = { .Tsns = 1000 };
+	while (bRun) {
+		ds18x20Sense(&sEWP);
+		ds1990Sense(&sEWP);
+		++Passes;
+		vTaskDelay(pdMS_TO_TICKS(2));
+	}
+	vTaskDelete(NULL);
+}
+
+int main(int argc, char * argv[]) {
+	bool bBack = (argc > 1 && strcmp(argv[1], "-b") == 0);
+	static i2c_di_t sI2C = { .Addr = 0x18 };
+	if (ds248xIdentify(&sI2C) != erSUCCESS || ds248xConfig(&sI2C) < erSUCCESS) {
+		printf("DS248x simulator not found\n");
+		return 1;
+	}
+	OWP_Config();
+	if (bBack && xTaskCreate(vBackground, "owBack", 0, NULL, 1, NULL) != pdPASS)
+		return 1;
+	report_t sRprt = { 0 };
+	int Fail = OWP_Bench(&sRprt);
+	bRun = 0;
+	if (bBack)
+		printf("background,%lu passes\n", (unsigned long) Passes);
+	return Fail;
+}
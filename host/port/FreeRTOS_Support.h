@@ -0,0 +1,89 @@
+// FreeRTOS_Support.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: the FreeRTOS subset used by the component, implemented on pthreads in rtos_host.c
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ############################################# Macros ############################################
+
+#define	configTICK_RATE_HZ			1000
+#define	configTIMER_TASK_PRIORITY	1
+#define	portTICK_PERIOD_MS			(1000 / configTICK_RATE_HZ)
+#define	portMAX_DELAY				0xFFFFFFFFUL
+#define	pdMS_TO_TICKS(x)			((TickType_t) (((u64_t) (x) * configTICK_RATE_HZ) / 1000))
+#define	pdTRUE						1
+#define	pdFALSE						0
+#define	pdPASS						pdTRUE
+#define	pdFAIL						pdFALSE
+#define	tskNO_AFFINITY				0x7FFFFFFF
+
+// ############################################# Types #############################################
+
+typedef u32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef u32_t EventBits_t;
+
+typedef struct host_sem_t * SemaphoreHandle_t;
+typedef struct host_timer_t * TimerHandle_t;
+typedef struct host_task_t * TaskHandle_t;
+typedef struct host_queue_t * QueueHandle_t;
+typedef struct host_eg_t * EventGroupHandle_t;
+
+typedef struct StaticTimer_t { void * pvDummy[8]; u64_t Dummy[4]; } StaticTimer_t;	// holds a host_timer_t
+
+typedef enum { eNoAction, eSetBits, eIncrement, eSetValueWithOverwrite } eNotifyAction;
+
+// ########################################### Functions ###########################################
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t Ticks);
+#define	portYIELD()					vTaskDelay(0)
+
+BaseType_t xTaskCreate(void (* pvFunc)(void *), const char * pcName, u32_t Stack, void * pvPara,
+	UBaseType_t Pri, TaskHandle_t * pHandle);
+BaseType_t xTaskCreatePinnedToCore(void (* pvFunc)(void *), const char * pcName, u32_t Stack,
+	void * pvPara, UBaseType_t Pri, TaskHandle_t * pHandle, BaseType_t Core);
+void vTaskDelete(TaskHandle_t hTask);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t hTask);
+BaseType_t xTaskNotify(TaskHandle_t hTask, u32_t Value, eNotifyAction Action);
+BaseType_t xTaskNotifyGive(TaskHandle_t hTask);
+u32_t ulTaskNotifyTake(BaseType_t bClear, TickType_t Ticks);
+
+/* Mutexes are created on first take, a plain (non recursive) mutex as in the firmware support */
+BaseType_t xRtosSemaphoreTake(SemaphoreHandle_t * pSem, TickType_t Ticks);
+BaseType_t xRtosSemaphoreGive(SemaphoreHandle_t * pSem);
+BaseType_t xRtosSemaphoreCheckCurrent(SemaphoreHandle_t * pSem);
+void vSemaphoreDelete(SemaphoreHandle_t hSem);
+
+TimerHandle_t xTimerCreateStatic(const char * pcName, TickType_t Period, BaseType_t Reload, void * pvID,
+	void (* pvFunc)(TimerHandle_t), StaticTimer_t * psBuf);
+BaseType_t xTimerStart(TimerHandle_t hTmr, TickType_t Ticks);
+BaseType_t xTimerStop(TimerHandle_t hTmr, TickType_t Ticks);
+void vTimerSetTimerID(TimerHandle_t hTmr, void * pvID);
+void * pvTimerGetTimerID(TimerHandle_t hTmr);
+
+QueueHandle_t xQueueCreate(u32_t Len, u32_t Size);
+BaseType_t xQueueSend(QueueHandle_t hQue, const void * pvItem, TickType_t Ticks);
+BaseType_t xQueueSendFromISR(QueueHandle_t hQue, const void * pvItem, BaseType_t * pbWoken);
+BaseType_t xQueueReceive(QueueHandle_t hQue, void * pvItem, TickType_t Ticks);
+BaseType_t xQueueReset(QueueHandle_t hQue);
+
+EventGroupHandle_t xEventGroupCreate(void);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t hEG, EventBits_t Bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t hEG, EventBits_t Bits);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t hEG, EventBits_t Bits, BaseType_t bClear,
+	BaseType_t bAll, TickType_t Ticks);
+
+struct report_t;
+int	xRtosReportTimer(struct report_t * psR, TimerHandle_t hTmr);
+
+#ifdef __cplusplus
+}
+#endif
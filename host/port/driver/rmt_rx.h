@@ -0,0 +1,41 @@
+// rmt_rx.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: ESP-IDF RMT driver subset, see rmt_tx.h
+
+#pragma once
+
+#include "driver/rmt_tx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rmt_rx_channel_config_t {
+	int gpio_num;
+	rmt_clock_source_t clk_src;
+	uint32_t resolution_hz;
+	size_t mem_block_symbols;
+	int intr_priority;
+	struct { uint32_t invert_in:1, with_dma:1, io_loop_back:1; } flags;
+} rmt_rx_channel_config_t;
+
+typedef struct rmt_receive_config_t {
+	uint32_t signal_range_min_ns;
+	uint32_t signal_range_max_ns;
+} rmt_receive_config_t;
+
+typedef struct rmt_rx_done_event_data_t {
+	rmt_symbol_word_t * received_symbols;
+	size_t num_symbols;
+} rmt_rx_done_event_data_t;
+
+typedef bool (* rmt_rx_done_callback_t)(rmt_channel_handle_t hChan, const rmt_rx_done_event_data_t * psEvt, void * pvArg);
+
+typedef struct rmt_rx_event_callbacks_t { rmt_rx_done_callback_t on_recv_done; } rmt_rx_event_callbacks_t;
+
+esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t * psCfg, rmt_channel_handle_t * phChan);
+esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t hChan, const rmt_rx_event_callbacks_t * psCB, void * pvArg);
+esp_err_t rmt_receive(rmt_channel_handle_t hChan, void * pvBuf, size_t Size, const rmt_receive_config_t * psCfg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,76 @@
+// rmt_tx.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: ESP-IDF RMT driver subset, TX looped back to the RX channel on the same GPIO
+// through an optional line model, see rmt_host_line()
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define	SOC_RMT_MEM_WORDS_PER_CHANNEL	48
+
+typedef enum { RMT_CLK_SRC_DEFAULT } rmt_clock_source_t;
+
+typedef struct rmt_channel_t * rmt_channel_handle_t;
+typedef struct rmt_encoder_t * rmt_encoder_handle_t;
+
+typedef union rmt_symbol_word_t {
+	struct { uint16_t duration0:15, level0:1, duration1:15, level1:1; };
+	uint32_t val;
+} rmt_symbol_word_t;
+
+typedef struct rmt_tx_channel_config_t {
+	int gpio_num;
+	rmt_clock_source_t clk_src;
+	uint32_t resolution_hz;
+	size_t mem_block_symbols;
+	size_t trans_queue_depth;
+	int intr_priority;
+	struct { uint32_t invert_out:1, with_dma:1, io_loop_back:1, io_od_mode:1; } flags;
+} rmt_tx_channel_config_t;
+
+typedef struct rmt_transmit_config_t {
+	int loop_count;
+	struct { uint32_t eot_level:1, queue_nonblocking:1; } flags;
+} rmt_transmit_config_t;
+
+typedef struct rmt_copy_encoder_config_t { int Dummy; } rmt_copy_encoder_config_t;
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t * psCfg, rmt_channel_handle_t * phChan);
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t * psCfg, rmt_encoder_handle_t * phEnc);
+esp_err_t rmt_transmit(rmt_channel_handle_t hChan, rmt_encoder_handle_t hEnc, const void * pvData, size_t Size,
+	const rmt_transmit_config_t * psCfg);
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t hChan, int Timeout);
+esp_err_t rmt_enable(rmt_channel_handle_t hChan);
+esp_err_t rmt_disable(rmt_channel_handle_t hChan);
+esp_err_t rmt_del_channel(rmt_channel_handle_t hChan);
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t hEnc);
+
+/**
+ * @brief	Host only: line model for the GPIO, turns the Num symbols transmitted into the symbols the
+ *			loop back receives (at most Max), as the master and the devices pull the line together.
+ *			Without a model (Func NULL) the receive is the transmit, an empty bus.
+ * @return	number of symbols received, the last one ended by the RX idle threshold
+ */
+typedef int (* rmt_host_line_t)(void * pvArg, const rmt_symbol_word_t * psTx, int Num, rmt_symbol_word_t * psRx, int Max);
+esp_err_t rmt_host_line(int Gpio, rmt_host_line_t Func, void * pvArg);
+
+/**
+ * @brief	Host only: number of rmt_transmit() calls on the GPIO since created
+ */
+uint32_t rmt_host_transmits(int Gpio);
+
+/**
+ * @brief	Host only: RX idle threshold (signal_range_max_ns) of the last rmt_receive() on the GPIO
+ */
+uint32_t rmt_host_rx_idle(int Gpio);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,59 @@
+// uart.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: ESP-IDF UART driver subset on a tty (termios), see uart_host_path()
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define	UART_NUM_MAX				3
+#define	UART_PIN_NO_CHANGE			(-1)
+
+typedef int uart_port_t;
+
+typedef enum { UART_DATA_5_BITS, UART_DATA_6_BITS, UART_DATA_7_BITS, UART_DATA_8_BITS } uart_word_length_t;
+typedef enum { UART_PARITY_DISABLE, UART_PARITY_EVEN = 2, UART_PARITY_ODD } uart_parity_t;
+typedef enum { UART_STOP_BITS_1 = 1, UART_STOP_BITS_1_5, UART_STOP_BITS_2 } uart_stop_bits_t;
+typedef enum { UART_HW_FLOWCTRL_DISABLE, UART_HW_FLOWCTRL_RTS, UART_HW_FLOWCTRL_CTS } uart_hw_flowcontrol_t;
+typedef enum { UART_SCLK_DEFAULT } uart_sclk_t;
+
+typedef enum {
+	UART_SIGNAL_INV_DISABLE = 0,
+	UART_SIGNAL_TXD_INV = 1 << 5,					// a tty sends a break instead
+} uart_signal_inv_t;
+
+typedef struct uart_config_t {
+	int baud_rate;
+	uart_word_length_t data_bits;
+	uart_parity_t parity;
+	uart_stop_bits_t stop_bits;
+	uart_hw_flowcontrol_t flow_ctrl;
+	uint8_t rx_flow_ctrl_thresh;
+	uart_sclk_t source_clk;
+} uart_config_t;
+
+/**
+ * @brief	Host only: tty device (eg /dev/ttyUSB0 or a pseudo-terminal) opened for Port by
+ *			uart_driver_install(), NULL to unmap. Unmapped ports fail to install.
+ */
+esp_err_t uart_host_path(uart_port_t Port, const char * pcPath);
+
+esp_err_t uart_driver_install(uart_port_t Port, int RxSize, int TxSize, int QueSize, void * pvQue, int Flags);
+esp_err_t uart_driver_delete(uart_port_t Port);
+esp_err_t uart_param_config(uart_port_t Port, const uart_config_t * psCfg);
+esp_err_t uart_set_pin(uart_port_t Port, int TxD, int RxD, int Rts, int Cts);
+esp_err_t uart_set_baudrate(uart_port_t Port, uint32_t Baud);
+esp_err_t uart_set_line_inverse(uart_port_t Port, uint32_t Mask);
+int	uart_write_bytes(uart_port_t Port, const void * pvSrc, size_t Size);
+int	uart_read_bytes(uart_port_t Port, void * pvDst, uint32_t Size, uint32_t Ticks);
+esp_err_t uart_flush_input(uart_port_t Port);
+esp_err_t uart_wait_tx_done(uart_port_t Port, uint32_t Ticks);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,43 @@
+// endpoints.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: the part of the application endpoint table the component configures
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { vtVALUE };
+enum { cvU32, cvI32, cvF32 };
+enum { URI_UNKNOWN, URI_DS18X20, URI_DS1990X, URI_NUM };
+
+struct epw_t;
+typedef struct vt_enum_t {
+	struct epw_t * (* work)(int);
+	void (* reset)(struct epw_t *, struct epw_t *);
+	void (* sense)(struct epw_t *, struct epw_t *);
+} vt_enum_t;
+
+typedef struct epw_t {
+	struct {
+		u32_t def;
+		struct {
+			union { float f32; u32_t u32; i32_t i32; } x32;
+			struct { const vt_enum_t * psCX; } ps;
+		} val;
+	} var;
+	u32_t Tsns, Rsns;
+	u16_t idx;
+	u8_t uri;
+	u8_t fSECsns;
+} epw_t;
+
+#define	SETDEF_CVAR(a,b,c,d,e,f,g)	((u32_t) (e))	// value count only
+
+extern epw_t table_work[URI_NUM];
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+// errors_events.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: framework error codes & event numbers used by the component
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+	erINV_INDEX = -12, erTIMEOUT, erINV_SIZE, erINV_PARA, erBUSY, erINV_DEVICE, erINV_STATE,
+	erNO_MEM, erINV_MODE, erINV_OPERATION, erINV_VALUE, erFAILURE, erSUCCESS = 0,
+};
+
+#define	evtFIRST_OW					8				// 1st of 8 1-Wire (iButton) channel event bits
+
+#ifdef __cplusplus
+}
+#endif
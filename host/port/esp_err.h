@@ -0,0 +1,25 @@
+// esp_err.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: ESP-IDF error codes
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef int esp_err_t;
+
+#define	ESP_OK						0
+#define	ESP_FAIL					-1
+#define	ESP_ERR_NO_MEM				0x101
+#define	ESP_ERR_INVALID_ARG			0x102
+#define	ESP_ERR_INVALID_STATE		0x103
+#define	ESP_ERR_NOT_FOUND			0x105
+#define	ESP_ERR_NOT_SUPPORTED		0x106
+#define	ESP_ERR_TIMEOUT				0x107
+
+const char * esp_err_to_name(esp_err_t Code);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+// esp_partition.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: no flash partitions, every lookup fails
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum { ESP_PARTITION_TYPE_APP, ESP_PARTITION_TYPE_DATA } esp_partition_type_t;
+typedef enum { ESP_PARTITION_SUBTYPE_ANY = 0xFF } esp_partition_subtype_t;
+typedef enum { ESP_PARTITION_MMAP_DATA, ESP_PARTITION_MMAP_INST } esp_partition_mmap_memory_t;
+typedef uint32_t esp_partition_mmap_handle_t;
+
+typedef struct esp_partition_t {
+	esp_partition_type_t type;
+	uint32_t address;
+	uint32_t size;
+	char label[17];
+} esp_partition_t;
+
+const esp_partition_t * esp_partition_find_first(esp_partition_type_t Type, esp_partition_subtype_t Sub,
+	const char * pcLabel);
+esp_err_t esp_partition_mmap(const esp_partition_t * psPart, size_t Offset, size_t Size,
+	esp_partition_mmap_memory_t Mem, const void ** ppvOut, esp_partition_mmap_handle_t * pHandle);
+void esp_partition_munmap(esp_partition_mmap_handle_t Handle);
+
+#ifdef __cplusplus
+}
+#endif
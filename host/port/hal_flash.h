@@ -0,0 +1,6 @@
+// hal_flash.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: nothing used by the component
+
+#pragma once
+
+#include "hal_platform.h"
@@ -0,0 +1,138 @@
+/*
+ * hal_host.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host (linux) port: reporting, syslog, time and the framework stubs the component links against.
+ */
+
+#include "hal_platform.h"
+#include "hal_i2c_common.h"
+#include "hal_timer.h"
+#include "endpoints.h"
+#include "options.h"
+#include "string_general.h"
+#include "task_events.h"
+#include "esp_partition.h"
+
+#include <stdarg.h>
+#include <time.h>
+
+// ##################################### Global variables ##########################################
+
+sys_flags_t sSysFlags = { 0 };
+tsz_t sTSZ = { 0 };
+epw_t table_work[URI_NUM] = { 0 };
+
+// ######################################## Diagnostics ############################################
+
+void vHostAssert(const char * pcFile, int Line, const char * pcExpr) {
+	fprintf(stderr, "%s:%d assert '%s' failed\n", pcFile, Line, pcExpr);
+	abort();
+}
+
+void vSyslogHost(int Sev, const char * pcFunc, const char * pcFormat, ...) {
+	static int Level = -1;
+	if (Level < 0) {
+		const char * pcLevel = getenv("OW_LOGLEVEL");
+		Level = pcLevel ? atoi(pcLevel) : SL_SEV_WARNING;
+	}
+	if (Sev > Level)
+		return;
+	static const char * const caSev[] = { "EMER", "ALRT", "CRIT", "ERR", "WARN", "NOTI", "INFO", "DBG" };
+	fprintf(stderr, "%s %s: ", caSev[Sev & 7], pcFunc);
+	va_list vaList;
+	va_start(vaList, pcFormat);
+	vfprintf(stderr, pcFormat, vaList);
+	va_end(vaList);
+	fputc('\n', stderr);
+}
+
+// ########################################### Reporting ###########################################
+
+int	xReport(report_t * psR, const char * pcFormat, ...) {
+	va_list vaList;
+	va_start(vaList, pcFormat);
+	int iRV;
+	if (psR && psR->pcBuf && psR->Size) {
+		iRV = vsnprintf(psR->pcBuf, psR->Size, pcFormat, vaList);
+		size_t Used = (iRV < 0) ? 0 : ((size_t) iRV < psR->Size) ? (size_t) iRV : psR->Size - 1;
+		psR->pcBuf += Used;
+		psR->Size -= Used;
+	} else {
+		iRV = vprintf(pcFormat, vaList);
+	}
+	va_end(vaList);
+	return iRV;
+}
+
+int	xReportBitMap(report_t * psR, u32_t Val1, u32_t Val2, u32_t Mask, const char * const * pcMess) {
+	int iRV = 0;
+	for (int i = 31; i >= 0; --i) {
+		u32_t Bit = 1UL << i;
+		if ((Mask & Bit) == 0)
+			continue;
+		iRV += xReport(psR, (Val1 & Bit) ? "%s " : "~%s ", pcMess ? pcMess[31 - i] : "?");
+	}
+	return iRV;
+}
+
+int	snprintfx(char * pcBuf, size_t Size, const char * pcFormat, ...) {
+	va_list vaList;
+	va_start(vaList, pcFormat);
+	int iRV = vsnprintf(pcBuf, Size, pcFormat, vaList);
+	va_end(vaList);
+	return iRV;
+}
+
+// ######################################## Time & options #########################################
+
+u64_t halTIMER_ReadRunTime(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64_t) ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+seconds_t xTimeStampSeconds(u64_t usecs) { return (seconds_t) (usecs / 1000000ULL); }
+
+u64_t xTimeMakeTimeStamp(seconds_t Secs, int uSecs) { return (u64_t) Secs * 1000000ULL + uSecs; }
+
+u32_t xOptionGet(int Opt) { return 0; }
+
+void halEventUpdateDevice(u32_t Mask, int State) {}
+
+// ##################################### Framework stubs ###########################################
+
+int	halI2C_Queue(i2c_di_t * psI2C, int Type, u8_t * pTxBuf, size_t TxSize, u8_t * pRxBuf, size_t RxSize,
+	i2cq_p1_t p1, i2cq_p2_t p2) {
+	return erFAILURE;								// no I2C bus, DS248x are simulated
+}
+
+int	halI2C_DeviceReport(struct report_t * psR, void * pvI2C) {
+	i2c_di_t * psI2C = pvI2C;
+	return xReport(psR, "Addr=0x%02X Type=%d ", psI2C->Addr, psI2C->Type);
+}
+
+const esp_partition_t * esp_partition_find_first(esp_partition_type_t Type, esp_partition_subtype_t Sub,
+	const char * pcLabel) {
+	return NULL;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t * psPart, size_t Offset, size_t Size,
+	esp_partition_mmap_memory_t Mem, const void ** ppvOut, esp_partition_mmap_handle_t * pHandle) {
+	return ESP_ERR_NOT_FOUND;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t Handle) {}
+
+const char * esp_err_to_name(esp_err_t Code) {
+	switch (Code) {
+	case ESP_OK:				return "ESP_OK";
+	case ESP_FAIL:				return "ESP_FAIL";
+	case ESP_ERR_NO_MEM:		return "ESP_ERR_NO_MEM";
+	case ESP_ERR_INVALID_ARG:	return "ESP_ERR_INVALID_ARG";
+	case ESP_ERR_INVALID_STATE:	return "ESP_ERR_INVALID_STATE";
+	case ESP_ERR_NOT_FOUND:		return "ESP_ERR_NOT_FOUND";
+	case ESP_ERR_NOT_SUPPORTED:	return "ESP_ERR_NOT_SUPPORTED";
+	case ESP_ERR_TIMEOUT:		return "ESP_ERR_TIMEOUT";
+	default:					return "ESP_ERR_?";
+	}
+}
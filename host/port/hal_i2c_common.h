@@ -0,0 +1,30 @@
+// hal_i2c_common.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: I2C device info, there is no I2C bus, DS248x are simulated (ds248xSIMULATE)
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { i2cDEV_UNDEF, i2cDEV_DS2484, i2cDEV_DS2482_10X, i2cDEV_DS2482_800 };
+enum { i2cSPEED_100, i2cSPEED_400 };
+enum { i2cW = 0, i2cR, i2cWR, i2cWDR_B };
+
+typedef void * i2cq_p1_t;
+typedef void * i2cq_p2_t;
+
+typedef struct i2c_di_t {
+	u8_t Addr, DevIdx, Type, Speed, TObus;
+	u8_t Test:1, IDok:1, CFGok:1, IgnoreACK:1, Spare:4;
+} i2c_di_t;
+
+int	halI2C_Queue(i2c_di_t * psI2C, int Type, u8_t * pTxBuf, size_t TxSize, u8_t * pRxBuf, size_t RxSize,
+	i2cq_p1_t p1, i2cq_p2_t p2);
+int	halI2C_DeviceReport(struct report_t * psR, void * pvI2C);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,10 @@
+// hal_memory.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: address class checks, any address is valid
+
+#pragma once
+
+#include "hal_platform.h"
+
+#define	halMemorySRAM(p)			((p) != NULL)
+#define	halMemoryEXE(p)				((p) != NULL)
+#define	halMemoryANY(p)				((p) != NULL)
@@ -0,0 +1,93 @@
+// hal_platform.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: stands in for the board & framework configuration of a firmware build
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ############################################# Types #############################################
+
+typedef uint8_t		u8_t;
+typedef int8_t		i8_t;
+typedef int8_t		s8_t;
+typedef uint16_t	u16_t;
+typedef int16_t		i16_t;
+typedef uint32_t	u32_t;
+typedef int32_t		i32_t;
+typedef uint64_t	u64_t;
+typedef int64_t		i64_t;
+typedef u32_t		seconds_t;
+
+// ##################################### Hardware configuration ####################################
+
+/* Everything the component supports is built on the host, with the DS248x simulator replacing the
+ * I2C bridges. The backends are set from host/CMakeLists.txt, these are the defaults. */
+#define	HAL_ONEWIRE					1
+#define	HAL_DS248X					1
+#define	HAL_DS18X20					1
+#define	HAL_DS1990X					1
+
+#ifndef HAL_DS2480B
+	#define	HAL_DS2480B				0
+#endif
+
+#ifndef halRMT_1W
+	#define	halRMT_1W				0
+#endif
+
+#define	HW_AC01						1
+#define	cmakePLTFRM					0
+#define	appPRODUCTION				0
+
+// ###################################### General macros ###########################################
+
+#define	debugFLAG_GLOBAL			0xFFFF
+#define	BITS_IN_BYTE				8
+#define	IRAM_ATTR
+
+/* Structure size asserts describe the 32 bit target layout, pointers are 8 bytes on the host */
+#define	DUMB_STATIC_ASSERT(x)
+
+#define	SO_MEM(t,m)					sizeof(((t *) 0)->m)
+#define	INRANGE(l,v,h)				(((l) <= (v)) && ((v) <= (h)))
+
+void vHostAssert(const char * pcFile, int Line, const char * pcExpr);
+#define	IF_myASSERT(f,x)			do { if ((f) && !(x)) vHostAssert(__FILE__, __LINE__, #x); } while (0)
+
+#define	PX(...)						printf(__VA_ARGS__)
+#define	IF_PX(f,...)				do { if (f) printf(__VA_ARGS__); } while (0)
+#define	IF_PXL(f,...)				do { if (f) printf(__VA_ARGS__); } while (0)
+#define	IF_EXEC_2(f,fn,a,b)			do { if (f) fn(a,b); } while (0)
+
+#define	RETURN_MX(m,x)				return (x)
+#define	IF_RETURN_X(c,x)			do { if (c) return (x); } while (0)
+#define	IF_RETURN_MX(c,m,x)			do { if (c) return (x); } while (0)
+
+#define	strNL						"\r\n"
+#define	CHR_0						'0'
+#define	CHR_1						'1'
+
+// ####################################### System status ###########################################
+
+typedef struct sys_flags_t { u8_t ac00; } sys_flags_t;
+extern sys_flags_t sSysFlags;
+
+#ifdef __cplusplus
+}
+#endif
+
+#include "FreeRTOS_Support.h"
+#include "errors_events.h"
+#include "report.h"
+#include "syslog.h"
+#include "options.h"
+#include "hal_timer.h"
+#include "task_events.h"
@@ -0,0 +1,21 @@
+// hal_timer.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: run time & time stamps
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tsz_t { u64_t usecs; } tsz_t;
+extern tsz_t sTSZ;
+
+u64_t halTIMER_ReadRunTime(void);					// uSec, monotonic
+seconds_t xTimeStampSeconds(u64_t usecs);
+u64_t xTimeMakeTimeStamp(seconds_t Secs, int uSecs);
+
+#ifdef __cplusplus
+}
+#endif
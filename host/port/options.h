@@ -0,0 +1,19 @@
+// options.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: run time debug options, all off
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { dbgOWscan, dbgDS1820, dbgMode, dbgDS248X, dbgDS1990x, dlyDS1990 };
+
+u32_t xOptionGet(int Opt);
+#define	OPT_GET(x)					xOptionGet(x)
+
+#ifdef __cplusplus
+}
+#endif
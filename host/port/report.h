@@ -0,0 +1,37 @@
+// report.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: report formatting, to stdout or a caller supplied buffer
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef union fm_t {
+	struct { u32_t uCount:23, bNL:1, bRT:1, bTskNum:1, b4:1, b5:1, b6:1, b7:1, b8:1, b9:1; };
+	u32_t u32Val;
+} fm_t;
+
+typedef struct report_t {
+	char * pcBuf;						// NULL = stdout
+	size_t Size;
+	fm_t sFM;
+} report_t;
+
+#define	makeMASK09x23(a,b,c,d,e,f,g,h,i,x)	\
+	((u32_t) (((a)<<23)|((b)<<24)|((c)<<25)|((d)<<26)|((e)<<27)|((f)<<28)|((g)<<29)|((h)<<30)|((u32_t)(i)<<31)|((x)&0x007FFFFF)))
+
+#define	repSIZE_SET(...)			0
+#define	fmTST(x)					(psR->sFM.x)
+#define	fmSET(x,v)					(psR->sFM.x = (v))
+#define	fmSAVE()					fm_t sFMsave = psR->sFM
+#define	fmBACK(x)					(psR->sFM.x = sFMsave.x)
+
+int	xReport(report_t * psR, const char * pcFormat, ...);
+int	xReportBitMap(report_t * psR, u32_t Val1, u32_t Val2, u32_t Mask, const char * const * pcMess);
+
+#ifdef __cplusplus
+}
+#endif
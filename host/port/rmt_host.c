@@ -0,0 +1,159 @@
+/*
+ * rmt_host.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host (linux) port: ESP-IDF RMT driver subset. A transmit completes immediately, the RX channel on
+ * the same GPIO (armed by rmt_receive) gets the symbols from the line model, the receive done
+ * callback runs in the transmitting task.
+ */
+
+#include "hal_platform.h"
+#include "driver/rmt_rx.h"
+
+#include <string.h>
+
+// ##################################### Local structures ##########################################
+
+typedef struct rmt_channel_t {
+	int Gpio;
+	bool IsRx, Enabled;
+	rmt_rx_done_callback_t pfDone;
+	void * pvArg;
+	rmt_symbol_word_t * psBuf;						// armed receive, NULL if none
+	size_t Max;
+} rmt_channel_t;
+
+typedef struct rmt_encoder_t { int Dummy; } rmt_encoder_t;
+
+typedef struct rmt_line_t {
+	int Gpio;
+	rmt_host_line_t Func;
+	void * pvArg;
+	uint32_t Transmits;
+	uint32_t IdleNs;								// last receive
+} rmt_line_t;
+
+// ###################################### Local variables ##########################################
+
+#define	rmtHOST_CHANNELS			8
+
+static rmt_channel_t saChan[rmtHOST_CHANNELS];
+static rmt_line_t saLine[rmtHOST_CHANNELS];
+static int ChanNum = 0, LineNum = 0;
+static rmt_encoder_t sEnc;
+
+// ###################################### Local functions ##########################################
+
+static rmt_line_t * psRmtLine(int Gpio) {
+	for (int i = 0; i < LineNum; ++i) {
+		if (saLine[i].Gpio == Gpio)
+			return &saLine[i];
+	}
+	if (LineNum == rmtHOST_CHANNELS)
+		return NULL;
+	saLine[LineNum] = (rmt_line_t) { .Gpio = Gpio };
+	return &saLine[LineNum++];
+}
+
+static esp_err_t xRmtNewChannel(int Gpio, bool IsRx, rmt_channel_handle_t * phChan) {
+	if (ChanNum == rmtHOST_CHANNELS || psRmtLine(Gpio) == NULL)
+		return ESP_ERR_NOT_FOUND;
+	saChan[ChanNum] = (rmt_channel_t) { .Gpio = Gpio, .IsRx = IsRx };
+	*phChan = &saChan[ChanNum++];
+	return ESP_OK;
+}
+
+/**
+ * @brief	Empty bus: the loop back is the transmit, the last high is not a level (idle)
+ */
+static int xRmtLoopBack(const rmt_symbol_word_t * psTx, int Num, rmt_symbol_word_t * psRx, int Max) {
+	if (Num > Max)
+		Num = Max;
+	memcpy(psRx, psTx, Num * sizeof(rmt_symbol_word_t));
+	if (Num)
+		psRx[Num - 1].duration1 = 0;
+	return Num;
+}
+
+// ####################################### Public functions ########################################
+
+esp_err_t rmt_new_tx_channel(const rmt_tx_channel_config_t * psCfg, rmt_channel_handle_t * phChan) {
+	return xRmtNewChannel(psCfg->gpio_num, 0, phChan);
+}
+
+esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t * psCfg, rmt_channel_handle_t * phChan) {
+	return xRmtNewChannel(psCfg->gpio_num, 1, phChan);
+}
+
+esp_err_t rmt_new_copy_encoder(const rmt_copy_encoder_config_t * psCfg, rmt_encoder_handle_t * phEnc) {
+	*phEnc = &sEnc;
+	return ESP_OK;
+}
+
+esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t hChan, const rmt_rx_event_callbacks_t * psCB, void * pvArg) {
+	if (!hChan->IsRx)
+		return ESP_ERR_INVALID_ARG;
+	hChan->pfDone = psCB->on_recv_done;
+	hChan->pvArg = pvArg;
+	return ESP_OK;
+}
+
+esp_err_t rmt_enable(rmt_channel_handle_t hChan) { hChan->Enabled = 1; return ESP_OK; }
+
+esp_err_t rmt_disable(rmt_channel_handle_t hChan) { hChan->Enabled = 0; return ESP_OK; }
+
+esp_err_t rmt_del_channel(rmt_channel_handle_t hChan) { hChan->Gpio = -1; return ESP_OK; }
+
+esp_err_t rmt_del_encoder(rmt_encoder_handle_t hEnc) { return ESP_OK; }
+
+esp_err_t rmt_receive(rmt_channel_handle_t hChan, void * pvBuf, size_t Size, const rmt_receive_config_t * psCfg) {
+	if (!hChan->IsRx || !hChan->Enabled)
+		return ESP_ERR_INVALID_STATE;
+	hChan->psBuf = pvBuf;
+	hChan->Max = Size / sizeof(rmt_symbol_word_t);
+	psRmtLine(hChan->Gpio)->IdleNs = psCfg->signal_range_max_ns;
+	return ESP_OK;
+}
+
+esp_err_t rmt_transmit(rmt_channel_handle_t hChan, rmt_encoder_handle_t hEnc, const void * pvData, size_t Size,
+	const rmt_transmit_config_t * psCfg) {
+	if (hChan->IsRx || !hChan->Enabled)
+		return ESP_ERR_INVALID_STATE;
+	rmt_line_t * psLine = psRmtLine(hChan->Gpio);
+	++psLine->Transmits;
+	rmt_channel_t * psRx = NULL;
+	for (int i = 0; i < ChanNum; ++i) {
+		if (saChan[i].IsRx && saChan[i].Gpio == hChan->Gpio && saChan[i].psBuf)
+			psRx = &saChan[i];
+	}
+	if (psRx == NULL)								// nothing listening, symbols are lost
+		return ESP_OK;
+	int Num = Size / sizeof(rmt_symbol_word_t);
+	int Rcvd = psLine->Func ? psLine->Func(psLine->pvArg, pvData, Num, psRx->psBuf, psRx->Max)
+							: xRmtLoopBack(pvData, Num, psRx->psBuf, psRx->Max);
+	rmt_rx_done_event_data_t sEvt = { .received_symbols = psRx->psBuf, .num_symbols = Rcvd };
+	psRx->psBuf = NULL;
+	if (psRx->pfDone)
+		psRx->pfDone(psRx, &sEvt, psRx->pvArg);
+	return ESP_OK;
+}
+
+esp_err_t rmt_tx_wait_all_done(rmt_channel_handle_t hChan, int Timeout) { return ESP_OK; }
+
+esp_err_t rmt_host_line(int Gpio, rmt_host_line_t Func, void * pvArg) {
+	rmt_line_t * psLine = psRmtLine(Gpio);
+	if (psLine == NULL)
+		return ESP_ERR_NO_MEM;
+	psLine->Func = Func;
+	psLine->pvArg = pvArg;
+	return ESP_OK;
+}
+
+uint32_t rmt_host_transmits(int Gpio) {
+	rmt_line_t * psLine = psRmtLine(Gpio);
+	return psLine ? psLine->Transmits : 0;
+}
+
+uint32_t rmt_host_rx_idle(int Gpio) {
+	rmt_line_t * psLine = psRmtLine(Gpio);
+	return psLine ? psLine->IdleNs : 0;
+}
@@ -0,0 +1,476 @@
+/*
+ * rtos_host.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host (linux) port: the FreeRTOS subset used by the component, on pthreads.
+ * Every task is a thread, the thread running main() is a task as well. Ticks are real mSec. Software
+ * timers run in their own service task, as the FreeRTOS timer daemon.
+ * As on the POSIX port of FreeRTOS, only tasks may call these functions: a thread not created by
+ * xTaskCreate() doing so is a bug on the target and aborts here.
+ */
+
+#include "hal_platform.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+
+// ##################################### Local structures ##########################################
+
+typedef struct host_task_t {
+	void (* pvFunc)(void *);
+	void * pvPara;
+	const char * pcName;
+	UBaseType_t Pri;
+	pthread_mutex_t mtx;
+	pthread_cond_t cv;
+	u32_t Notify;
+} host_task_t;
+
+typedef struct host_sem_t {
+	pthread_mutex_t mtx;
+	pthread_cond_t cv;
+	host_task_t * psOwner;							// NULL = free
+} host_sem_t;
+
+typedef struct host_timer_t {
+	struct host_timer_t * psNext;
+	const char * pcName;
+	void (* pvFunc)(TimerHandle_t);
+	void * pvID;
+	TickType_t Period;
+	TickType_t Texp;
+	u8_t Reload;
+	u8_t Active;
+} host_timer_t;
+
+typedef struct host_queue_t {
+	pthread_mutex_t mtx;
+	pthread_cond_t cv;
+	u32_t Len, Size, Head, Count;
+	u8_t Buf[];
+} host_queue_t;
+
+typedef struct host_eg_t {
+	pthread_mutex_t mtx;
+	pthread_cond_t cv;
+	EventBits_t Bits;
+} host_eg_t;
+
+_Static_assert(sizeof(host_timer_t) <= sizeof(StaticTimer_t), "StaticTimer_t too small");
+
+// ###################################### Local variables ##########################################
+
+static host_task_t sMain = { .pcName = "main", .Pri = 1, .mtx = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER };
+static __thread host_task_t * psSelf = NULL;
+static pthread_t tMain;
+static struct timespec tsBoot;
+
+static pthread_mutex_t mtxLazy = PTHREAD_MUTEX_INITIALIZER;	// lazy semaphore creation
+
+static pthread_mutex_t mtxTmr = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t cvTmr = PTHREAD_COND_INITIALIZER;
+static host_timer_t * psTimers = NULL;
+static bool TmrTask = 0;
+
+// ##################################### Global variables ##########################################
+
+TaskHandle_t EventsHandle = NULL;
+
+// ###################################### Local functions ##########################################
+
+__attribute__((constructor)) static void vRtosHostInit(void) {
+	tMain = pthread_self();
+	clock_gettime(CLOCK_MONOTONIC, &tsBoot);
+}
+
+static host_task_t * psRtosSelf(const char * pcFunc) {
+	if (psSelf)
+		return psSelf;
+	if (pthread_equal(pthread_self(), tMain))
+		return psSelf = &sMain;
+	fprintf(stderr, "%s() called from a thread that is not a task\n", pcFunc);
+	abort();
+}
+
+/**
+ * @brief	Absolute CLOCK_REALTIME deadline Ticks from now, for the pthread timed waits
+ */
+static struct timespec sRtosDeadline(TickType_t Ticks) {
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	u64_t nSec = (u64_t) ts.tv_nsec + (u64_t) Ticks * (1000000000ULL / configTICK_RATE_HZ);
+	ts.tv_sec += nSec / 1000000000ULL;
+	ts.tv_nsec = nSec % 1000000000ULL;
+	return ts;
+}
+
+/**
+ * @brief	Wait on cv (mtx held) until woken or the deadline passes
+ * @return	0 if woken, ETIMEDOUT if the deadline passed
+ */
+static int xRtosWait(pthread_cond_t * pcv, pthread_mutex_t * pmtx, TickType_t Ticks, struct timespec * psDL) {
+	if (Ticks == portMAX_DELAY)
+		return pthread_cond_wait(pcv, pmtx);
+	return pthread_cond_timedwait(pcv, pmtx, psDL);
+}
+
+static void vRtosCondInit(pthread_mutex_t * pmtx, pthread_cond_t * pcv) {
+	pthread_mutex_init(pmtx, NULL);
+	pthread_cond_init(pcv, NULL);
+}
+
+// ############################################# Tasks #############################################
+
+TickType_t xTaskGetTickCount(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	u64_t mSec = (u64_t) (ts.tv_sec - tsBoot.tv_sec) * 1000ULL + (ts.tv_nsec - tsBoot.tv_nsec) / 1000000L;
+	return (TickType_t) ((mSec * configTICK_RATE_HZ) / 1000ULL);
+}
+
+void vTaskDelay(TickType_t Ticks) {
+	psRtosSelf(__func__);
+	if (Ticks == 0) {
+		sched_yield();
+		return;
+	}
+	u64_t nSec = (u64_t) Ticks * (1000000000ULL / configTICK_RATE_HZ);
+	struct timespec ts = { .tv_sec = nSec / 1000000000ULL, .tv_nsec = nSec % 1000000000ULL };
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR);
+}
+
+static void * pvRtosTask(void * pvPara) {
+	psSelf = pvPara;
+	psSelf->pvFunc(psSelf->pvPara);
+	fprintf(stderr, "Task '%s' returned, must vTaskDelete(NULL)\n", psSelf->pcName);
+	abort();
+}
+
+BaseType_t xTaskCreate(void (* pvFunc)(void *), const char * pcName, u32_t Stack, void * pvPara,
+	UBaseType_t Pri, TaskHandle_t * pHandle) {
+	host_task_t * psTask = calloc(1, sizeof(host_task_t));
+	if (psTask == NULL)
+		return pdFAIL;
+	*psTask = (host_task_t) { .pvFunc = pvFunc, .pvPara = pvPara, .pcName = pcName, .Pri = Pri };
+	vRtosCondInit(&psTask->mtx, &psTask->cv);
+	pthread_attr_t sAttr;
+	pthread_attr_init(&sAttr);
+	pthread_attr_setdetachstate(&sAttr, PTHREAD_CREATE_DETACHED);
+	pthread_t tID;
+	int iRV = pthread_create(&tID, &sAttr, pvRtosTask, psTask);
+	pthread_attr_destroy(&sAttr);
+	if (iRV != 0) {
+		free(psTask);
+		return pdFAIL;
+	}
+	if (pHandle)
+		*pHandle = psTask;
+	return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (* pvFunc)(void *), const char * pcName, u32_t Stack,
+	void * pvPara, UBaseType_t Pri, TaskHandle_t * pHandle, BaseType_t Core) {
+	return xTaskCreate(pvFunc, pcName, Stack, pvPara, Pri, pHandle);
+}
+
+void vTaskDelete(TaskHandle_t hTask) {
+	host_task_t * psTask = psRtosSelf(__func__);
+	if (hTask && hTask != psTask) {
+		fprintf(stderr, "vTaskDelete() of another task is not supported\n");
+		abort();
+	}
+	if (psTask == &sMain)
+		exit(0);
+	pthread_exit(NULL);								// handle stays valid, it may still be notified
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return psRtosSelf(__func__); }
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t hTask) { return (hTask ? hTask : psRtosSelf(__func__))->Pri; }
+
+BaseType_t xTaskNotify(TaskHandle_t hTask, u32_t Value, eNotifyAction Action) {
+	psRtosSelf(__func__);
+	if (hTask == NULL)
+		return pdFAIL;
+	pthread_mutex_lock(&hTask->mtx);
+	switch (Action) {
+	case eSetBits:					hTask->Notify |= Value;	break;
+	case eIncrement:				++hTask->Notify;		break;
+	case eSetValueWithOverwrite:	hTask->Notify = Value;	break;
+	default:												break;
+	}
+	pthread_cond_broadcast(&hTask->cv);
+	pthread_mutex_unlock(&hTask->mtx);
+	return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t hTask) { return xTaskNotify(hTask, 0, eIncrement); }
+
+u32_t ulTaskNotifyTake(BaseType_t bClear, TickType_t Ticks) {
+	host_task_t * psTask = psRtosSelf(__func__);
+	struct timespec sDL = sRtosDeadline(Ticks);
+	pthread_mutex_lock(&psTask->mtx);
+	while (psTask->Notify == 0 && xRtosWait(&psTask->cv, &psTask->mtx, Ticks, &sDL) == 0);
+	u32_t Value = psTask->Notify;
+	if (Value)
+		psTask->Notify = bClear ? 0 : Value - 1;
+	pthread_mutex_unlock(&psTask->mtx);
+	return Value;
+}
+
+// ########################################### Semaphores ##########################################
+
+BaseType_t xRtosSemaphoreTake(SemaphoreHandle_t * pSem, TickType_t Ticks) {
+	host_task_t * psTask = psRtosSelf(__func__);
+	pthread_mutex_lock(&mtxLazy);
+	if (*pSem == NULL) {
+		host_sem_t * psSem = calloc(1, sizeof(host_sem_t));
+		if (psSem)
+			vRtosCondInit(&psSem->mtx, &psSem->cv);
+		*pSem = psSem;
+	}
+	host_sem_t * psSem = *pSem;
+	pthread_mutex_unlock(&mtxLazy);
+	if (psSem == NULL)
+		return pdFALSE;
+	pthread_mutex_lock(&psSem->mtx);
+	if (psSem->psOwner == psTask && Ticks == portMAX_DELAY) {
+		fprintf(stderr, "Task '%s' takes a mutex it holds, deadlock\n", psTask->pcName);
+		abort();
+	}
+	struct timespec sDL = sRtosDeadline(Ticks);
+	int iRV = 0;
+	while (psSem->psOwner && iRV == 0)
+		iRV = xRtosWait(&psSem->cv, &psSem->mtx, Ticks, &sDL);
+	if (psSem->psOwner == NULL)
+		psSem->psOwner = psTask;
+	BaseType_t bRV = (psSem->psOwner == psTask) ? pdTRUE : pdFALSE;
+	pthread_mutex_unlock(&psSem->mtx);
+	return bRV;
+}
+
+BaseType_t xRtosSemaphoreGive(SemaphoreHandle_t * pSem) {
+	host_task_t * psTask = psRtosSelf(__func__);
+	host_sem_t * psSem = *pSem;
+	if (psSem == NULL)
+		return pdFALSE;
+	pthread_mutex_lock(&psSem->mtx);
+	BaseType_t bRV = (psSem->psOwner == psTask) ? pdTRUE : pdFALSE;	// only the holder can give
+	if (bRV) {
+		psSem->psOwner = NULL;
+		pthread_cond_signal(&psSem->cv);
+	}
+	pthread_mutex_unlock(&psSem->mtx);
+	return bRV;
+}
+
+BaseType_t xRtosSemaphoreCheckCurrent(SemaphoreHandle_t * pSem) {
+	host_task_t * psTask = psRtosSelf(__func__);
+	host_sem_t * psSem = *pSem;
+	if (psSem == NULL)
+		return pdFALSE;
+	pthread_mutex_lock(&psSem->mtx);
+	BaseType_t bRV = (psSem->psOwner == psTask) ? pdTRUE : pdFALSE;
+	pthread_mutex_unlock(&psSem->mtx);
+	return bRV;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t hSem) {
+	if (hSem == NULL)
+		return;
+	pthread_mutex_destroy(&hSem->mtx);
+	pthread_cond_destroy(&hSem->cv);
+	free(hSem);
+}
+
+// ######################################## Software timers ########################################
+
+static void vRtosTimerTask(void * pvPara) {
+	pthread_mutex_lock(&mtxTmr);
+	while (1) {
+		host_timer_t * psNext = NULL;
+		for (host_timer_t * psT = psTimers; psT; psT = psT->psNext) {
+			if (psT->Active && (psNext == NULL || (i32_t) (psT->Texp - psNext->Texp) < 0))
+				psNext = psT;
+		}
+		if (psNext == NULL) {
+			pthread_cond_wait(&cvTmr, &mtxTmr);
+			continue;
+		}
+		TickType_t tNow = xTaskGetTickCount();
+		if ((i32_t) (psNext->Texp - tNow) > 0) {
+			struct timespec sDL = sRtosDeadline(psNext->Texp - tNow);
+			pthread_cond_timedwait(&cvTmr, &mtxTmr, &sDL);
+			continue;								// list may have changed, re-evaluate
+		}
+		if (psNext->Reload)
+			psNext->Texp += psNext->Period;
+		else
+			psNext->Active = 0;
+		pthread_mutex_unlock(&mtxTmr);
+		psNext->pvFunc(psNext);						// timer daemon context, as on the target
+		pthread_mutex_lock(&mtxTmr);
+	}
+}
+
+TimerHandle_t xTimerCreateStatic(const char * pcName, TickType_t Period, BaseType_t Reload, void * pvID,
+	void (* pvFunc)(TimerHandle_t), StaticTimer_t * psBuf) {
+	host_timer_t * psTmr = (host_timer_t *) psBuf;
+	*psTmr = (host_timer_t) { .pcName = pcName, .pvFunc = pvFunc, .pvID = pvID, .Period = Period, .Reload = Reload };
+	pthread_mutex_lock(&mtxTmr);
+	psTmr->psNext = psTimers;
+	psTimers = psTmr;
+	bool Start = (TmrTask == 0);
+	TmrTask = 1;
+	pthread_mutex_unlock(&mtxTmr);
+	if (Start && xTaskCreate(vRtosTimerTask, "Tmr Svc", 0, NULL, configTIMER_TASK_PRIORITY, NULL) != pdPASS)
+		return NULL;
+	return psTmr;
+}
+
+BaseType_t xTimerStart(TimerHandle_t hTmr, TickType_t Ticks) {
+	pthread_mutex_lock(&mtxTmr);
+	hTmr->Texp = xTaskGetTickCount() + hTmr->Period;
+	hTmr->Active = 1;
+	pthread_cond_signal(&cvTmr);
+	pthread_mutex_unlock(&mtxTmr);
+	return pdPASS;
+}
+
+BaseType_t xTimerStop(TimerHandle_t hTmr, TickType_t Ticks) {
+	pthread_mutex_lock(&mtxTmr);
+	hTmr->Active = 0;
+	pthread_cond_signal(&cvTmr);
+	pthread_mutex_unlock(&mtxTmr);
+	return pdPASS;
+}
+
+void vTimerSetTimerID(TimerHandle_t hTmr, void * pvID) {
+	pthread_mutex_lock(&mtxTmr);
+	hTmr->pvID = pvID;
+	pthread_mutex_unlock(&mtxTmr);
+}
+
+void * pvTimerGetTimerID(TimerHandle_t hTmr) {
+	pthread_mutex_lock(&mtxTmr);
+	void * pvID = hTmr->pvID;
+	pthread_mutex_unlock(&mtxTmr);
+	return pvID;
+}
+
+int	xRtosReportTimer(report_t * psR, TimerHandle_t hTmr) {
+	if (hTmr == NULL)
+		return xReport(psR, "Timer=NULL");
+	return xReport(psR, "%s Per=%lu Act=%d", hTmr->pcName, (unsigned long) hTmr->Period, hTmr->Active);
+}
+
+// ############################################# Queues ############################################
+
+QueueHandle_t xQueueCreate(u32_t Len, u32_t Size) {
+	host_queue_t * psQue = calloc(1, sizeof(host_queue_t) + Len * Size);
+	if (psQue == NULL)
+		return NULL;
+	vRtosCondInit(&psQue->mtx, &psQue->cv);
+	psQue->Len = Len;
+	psQue->Size = Size;
+	return psQue;
+}
+
+static BaseType_t xRtosQueuePut(QueueHandle_t hQue, const void * pvItem, TickType_t Ticks) {
+	struct timespec sDL = sRtosDeadline(Ticks);
+	pthread_mutex_lock(&hQue->mtx);
+	int iRV = 0;
+	while (hQue->Count == hQue->Len && Ticks && iRV == 0)
+		iRV = xRtosWait(&hQue->cv, &hQue->mtx, Ticks, &sDL);
+	BaseType_t bRV = pdFALSE;
+	if (hQue->Count < hQue->Len) {
+		memcpy(&hQue->Buf[((hQue->Head + hQue->Count) % hQue->Len) * hQue->Size], pvItem, hQue->Size);
+		++hQue->Count;
+		pthread_cond_broadcast(&hQue->cv);
+		bRV = pdTRUE;
+	}
+	pthread_mutex_unlock(&hQue->mtx);
+	return bRV;
+}
+
+BaseType_t xQueueSend(QueueHandle_t hQue, const void * pvItem, TickType_t Ticks) {
+	psRtosSelf(__func__);
+	return xRtosQueuePut(hQue, pvItem, Ticks);
+}
+
+/* The host "ISR" (eg the RMT receive done callback) runs in the task that caused it */
+BaseType_t xQueueSendFromISR(QueueHandle_t hQue, const void * pvItem, BaseType_t * pbWoken) {
+	if (pbWoken)
+		*pbWoken = pdFALSE;
+	return xRtosQueuePut(hQue, pvItem, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t hQue, void * pvItem, TickType_t Ticks) {
+	psRtosSelf(__func__);
+	struct timespec sDL = sRtosDeadline(Ticks);
+	pthread_mutex_lock(&hQue->mtx);
+	int iRV = 0;
+	while (hQue->Count == 0 && Ticks && iRV == 0)
+		iRV = xRtosWait(&hQue->cv, &hQue->mtx, Ticks, &sDL);
+	BaseType_t bRV = pdFALSE;
+	if (hQue->Count) {
+		memcpy(pvItem, &hQue->Buf[hQue->Head * hQue->Size], hQue->Size);
+		hQue->Head = (hQue->Head + 1) % hQue->Len;
+		--hQue->Count;
+		pthread_cond_broadcast(&hQue->cv);
+		bRV = pdTRUE;
+	}
+	pthread_mutex_unlock(&hQue->mtx);
+	return bRV;
+}
+
+BaseType_t xQueueReset(QueueHandle_t hQue) {
+	pthread_mutex_lock(&hQue->mtx);
+	hQue->Head = hQue->Count = 0;
+	pthread_cond_broadcast(&hQue->cv);
+	pthread_mutex_unlock(&hQue->mtx);
+	return pdPASS;
+}
+
+// ########################################## Event groups #########################################
+
+EventGroupHandle_t xEventGroupCreate(void) {
+	host_eg_t * psEG = calloc(1, sizeof(host_eg_t));
+	if (psEG)
+		vRtosCondInit(&psEG->mtx, &psEG->cv);
+	return psEG;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t hEG, EventBits_t Bits) {
+	pthread_mutex_lock(&hEG->mtx);
+	EventBits_t Now = (hEG->Bits |= Bits);
+	pthread_cond_broadcast(&hEG->cv);
+	pthread_mutex_unlock(&hEG->mtx);
+	return Now;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t hEG, EventBits_t Bits) {
+	pthread_mutex_lock(&hEG->mtx);
+	EventBits_t Was = hEG->Bits;
+	hEG->Bits &= ~Bits;
+	pthread_mutex_unlock(&hEG->mtx);
+	return Was;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t hEG, EventBits_t Bits, BaseType_t bClear,
+	BaseType_t bAll, TickType_t Ticks) {
+	psRtosSelf(__func__);
+	struct timespec sDL = sRtosDeadline(Ticks);
+	pthread_mutex_lock(&hEG->mtx);
+	int iRV = 0;
+	#define	rtosEG_MET()			(bAll ? (hEG->Bits & Bits) == Bits : (hEG->Bits & Bits) != 0)
+	while (!rtosEG_MET() && Ticks && iRV == 0)
+		iRV = xRtosWait(&hEG->cv, &hEG->mtx, Ticks, &sDL);
+	EventBits_t Now = hEG->Bits;
+	if (rtosEG_MET() && bClear)
+		hEG->Bits &= ~Bits;
+	pthread_mutex_unlock(&hEG->mtx);
+	return Now;
+}
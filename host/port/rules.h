@@ -0,0 +1,11 @@
+// rules.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: rule action parameters
+
+#pragma once
+
+#include "hal_platform.h"
+
+typedef struct rule_t {
+	u8_t ActIdx;
+	struct { union { i32_t i32; u32_t u32; } x32[4][6]; } para;
+} rule_t;
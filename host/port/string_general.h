@@ -0,0 +1,16 @@
+// string_general.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+
+#pragma once
+
+#include "hal_platform.h"
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int	snprintfx(char * pcBuf, size_t Size, const char * pcFormat, ...);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+// syslog.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: syslog to stderr, severity threshold from $OW_LOGLEVEL (default 4, warnings)
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { SL_SEV_EMERGENCY, SL_SEV_ALERT, SL_SEV_CRITICAL, SL_SEV_ERROR, SL_SEV_WARNING, SL_SEV_NOTICE,
+	SL_SEV_INFO, SL_SEV_DEBUG };
+
+void vSyslogHost(int Sev, const char * pcFunc, const char * pcFormat, ...);
+
+#define	SL_LOG(s,...)				vSyslogHost(s, __func__, __VA_ARGS__)
+#define	SL_ALRT(...)				SL_LOG(SL_SEV_ALERT, __VA_ARGS__)
+#define	SL_ERR(...)					SL_LOG(SL_SEV_ERROR, __VA_ARGS__)
+#define	SL_WARN(...)				SL_LOG(SL_SEV_WARNING, __VA_ARGS__)
+#define	SL_NOT(...)					SL_LOG(SL_SEV_NOTICE, __VA_ARGS__)
+#define	SL_INFO(...)				SL_LOG(SL_SEV_INFO, __VA_ARGS__)
+#define	SL_DBG(...)					SL_LOG(SL_SEV_DEBUG, __VA_ARGS__)
+#define	IF_SL_ERR(c,...)			do { if (c) SL_ERR(__VA_ARGS__); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,8 @@
+// systiming.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: debug timers compiled out
+
+#pragma once
+
+#define	IF_SYSTIMER_INIT(...)
+#define	IF_SYSTIMER_START(...)
+#define	IF_SYSTIMER_STOP(...)
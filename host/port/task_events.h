@@ -0,0 +1,20 @@
+// task_events.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+// Host (linux) port: event task & device status
+
+#pragma once
+
+#include "hal_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum { devMASK_DS18X20 = 1 << 0, devMASK_DS1990X = 1 << 1, devMASK_DS248X = 1 << 2 };
+
+extern TaskHandle_t EventsHandle;					// no events task on the host, NULL
+
+void halEventUpdateDevice(u32_t Mask, int State);
+
+#ifdef __cplusplus
+}
+#endif
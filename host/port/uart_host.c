@@ -0,0 +1,163 @@
+/*
+ * uart_host.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host (linux) port: ESP-IDF UART driver subset on a tty. uart_host_path() maps a port number to a
+ * device, a USB serial adapter (with a real DS2480B) or the master side of a pseudo-terminal.
+ * Pins are ignored, TXD inversion is sent as a break (a pty does not pass breaks on).
+ */
+
+#include "hal_platform.h"
+#include "driver/uart.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ###################################### Local variables ##########################################
+
+static const char * pcaPath[UART_NUM_MAX];
+static int iaFD[UART_NUM_MAX] = { [0 ... UART_NUM_MAX-1] = -1 };
+
+// ###################################### Local functions ##########################################
+
+static int xUartFD(uart_port_t Port) {
+	return (Port >= 0 && Port < UART_NUM_MAX) ? iaFD[Port] : -1;
+}
+
+static speed_t xUartSpeed(uint32_t Baud) {
+	switch (Baud) {
+	case 9600:		return B9600;
+	case 19200:		return B19200;
+	case 57600:		return B57600;
+	case 115200:	return B115200;
+	default:		return B0;
+	}
+}
+
+// ####################################### Public functions ########################################
+
+esp_err_t uart_host_path(uart_port_t Port, const char * pcPath) {
+	if (Port < 0 || Port >= UART_NUM_MAX)
+		return ESP_ERR_INVALID_ARG;
+	pcaPath[Port] = pcPath;
+	return ESP_OK;
+}
+
+esp_err_t uart_driver_install(uart_port_t Port, int RxSize, int TxSize, int QueSize, void * pvQue, int Flags) {
+	if (Port < 0 || Port >= UART_NUM_MAX || pcaPath[Port] == NULL)
+		return ESP_ERR_NOT_FOUND;
+	if (iaFD[Port] >= 0)
+		return ESP_ERR_INVALID_STATE;
+	int FD = open(pcaPath[Port], O_RDWR | O_NOCTTY);
+	if (FD < 0)
+		return ESP_FAIL;
+	struct termios sTIO;
+	if (tcgetattr(FD, &sTIO) != 0) {
+		close(FD);
+		return ESP_FAIL;
+	}
+	cfmakeraw(&sTIO);
+	sTIO.c_cflag |= CLOCAL | CREAD;
+	sTIO.c_cc[VMIN] = 0;
+	sTIO.c_cc[VTIME] = 0;
+	tcsetattr(FD, TCSANOW, &sTIO);
+	iaFD[Port] = FD;
+	return ESP_OK;
+}
+
+esp_err_t uart_driver_delete(uart_port_t Port) {
+	int FD = xUartFD(Port);
+	if (FD < 0)
+		return ESP_ERR_INVALID_STATE;
+	close(FD);
+	iaFD[Port] = -1;
+	return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t Port, const uart_config_t * psCfg) {
+	if (xUartFD(Port) < 0)
+		return ESP_ERR_INVALID_STATE;
+	if (psCfg->data_bits != UART_DATA_8_BITS || psCfg->parity != UART_PARITY_DISABLE ||
+		psCfg->stop_bits != UART_STOP_BITS_1)
+		return ESP_ERR_NOT_SUPPORTED;				// 8N1 only, as cfmakeraw()
+	return uart_set_baudrate(Port, psCfg->baud_rate);
+}
+
+esp_err_t uart_set_pin(uart_port_t Port, int TxD, int RxD, int Rts, int Cts) {
+	return (xUartFD(Port) < 0) ? ESP_ERR_INVALID_STATE : ESP_OK;
+}
+
+esp_err_t uart_set_baudrate(uart_port_t Port, uint32_t Baud) {
+	int FD = xUartFD(Port);
+	speed_t Speed = xUartSpeed(Baud);
+	struct termios sTIO;
+	if (FD < 0 || tcgetattr(FD, &sTIO) != 0)
+		return ESP_ERR_INVALID_STATE;
+	if (Speed == B0)
+		return ESP_ERR_INVALID_ARG;
+	cfsetspeed(&sTIO, Speed);
+	return (tcsetattr(FD, TCSADRAIN, &sTIO) == 0) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t uart_set_line_inverse(uart_port_t Port, uint32_t Mask) {
+	int FD = xUartFD(Port);
+	if (FD < 0)
+		return ESP_ERR_INVALID_STATE;
+	ioctl(FD, (Mask & UART_SIGNAL_TXD_INV) ? TIOCSBRK : TIOCCBRK);	// ignored by a pty
+	return ESP_OK;
+}
+
+int	uart_write_bytes(uart_port_t Port, const void * pvSrc, size_t Size) {
+	int FD = xUartFD(Port);
+	if (FD < 0)
+		return -1;
+	size_t Done = 0;
+	while (Done < Size) {
+		ssize_t iRV = write(FD, (const uint8_t *) pvSrc + Done, Size - Done);
+		if (iRV < 0 && errno != EINTR)
+			return -1;
+		if (iRV > 0)
+			Done += iRV;
+	}
+	return Done;
+}
+
+int	uart_read_bytes(uart_port_t Port, void * pvDst, uint32_t Size, uint32_t Ticks) {
+	int FD = xUartFD(Port);
+	if (FD < 0)
+		return -1;
+	TickType_t tEnd = xTaskGetTickCount() + Ticks;
+	uint32_t Done = 0;
+	while (Done < Size) {
+		i32_t Wait = (i32_t) (tEnd - xTaskGetTickCount());
+		struct pollfd sPFD = { .fd = FD, .events = POLLIN };
+		if (Wait < 0 || poll(&sPFD, 1, Wait * portTICK_PERIOD_MS) <= 0)
+			break;
+		ssize_t iRV = read(FD, (uint8_t *) pvDst + Done, Size - Done);
+		if (iRV < 0 && errno != EINTR && errno != EAGAIN)
+			return -1;
+		if (iRV > 0)
+			Done += iRV;
+	}
+	return Done;
+}
+
+esp_err_t uart_flush_input(uart_port_t Port) {
+	int FD = xUartFD(Port);
+	if (FD < 0)
+		return ESP_ERR_INVALID_STATE;
+	tcflush(FD, TCIFLUSH);
+	return ESP_OK;
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t Port, uint32_t Ticks) {
+	int FD = xUartFD(Port);
+	if (FD < 0)
+		return ESP_ERR_INVALID_STATE;
+	tcdrain(FD);
+	return ESP_OK;
+}
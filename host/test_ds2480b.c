@@ -0,0 +1,63 @@
+/*
+ * test_ds2480b.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host: DS2480B serial backend (ds2480b.c) through the UART port against the pty stand-in
+ * (ds2480bpty.c), 2x DS18B20 on the line. Covers detect & baud change, search accelerator, data
+ * mode escapes, strong pull-up and overdrive.
+ */
+
+#include "hal_platform.h"
+#include "onewire_platform.h"
+
+#include <string.h>
+
+extern u8_t Fam28Count;
+
+static int Fails = 0;
+
+#define	CHECK(x)					do { if (!(x)) { printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #x); ++Fails; } } while (0)
+
+int main(void) {
+	const char * pcPath = pcDS2480B_PtyOpen();
+	CHECK(pcPath != NULL);
+	if (pcPath == NULL)
+		return Fails;
+	CHECK(uart_host_path(1, pcPath) == ESP_OK);
+	OWP_Config();
+	CHECK(ds2480bCount == 1);
+	CHECK(Fam28Count == 2);
+	ds2480b_t * psDS2480B = &psaDS2480B[0];
+	CHECK(psDS2480B->Baud == ds2480bBAUD);
+
+	// TH = ds2480bMODE_COMMAND, must be doubled in data mode to stay data
+	ds18x20_t * psDS18X20 = &psaDS18X20[0];
+	ds18x20_t sDev = *psDS18X20;
+	sDev.Thi = ds2480bMODE_COMMAND;
+	sDev.Tlo = 0x11;
+	CHECK(OWP_BusSelect(&sDev.sOW) == 1);
+	CHECK(ds18x20WriteSP(&sDev) == 1);
+	sDev.Thi = sDev.Tlo = 0;
+	CHECK(ds18x20ReadSP(&sDev, 9) == 1);
+	CHECK(sDev.Thi == ds2480bMODE_COMMAND && sDev.Tlo == 0x11);
+	CHECK(sDev.Tlsb == 0x90 && sDev.Tmsb == 0x01);	// 25C at boot
+
+	// strong pull-up: primed on the last bit of the command byte, ended by a stop pulse
+	sDev.sOW.PSU = 0;
+	CHECK(OWResetCommand(&sDev.sOW, DS18X20_CONVERT, owADDR_MATCH, 1) == 1);
+	CHECK(psDS2480B->Pulse == 1);
+	CHECK(OWLevel(&sDev.sOW, owPOWER_STANDARD) == owPOWER_STANDARD);
+	CHECK(psDS2480B->Pulse == 0);
+
+	// overdrive (switches to 115200 first) & back
+	CHECK(ds2480bOWSpeed(psDS2480B, owSPEED_ODRIVE) == owSPEED_ODRIVE);
+	CHECK(psDS2480B->Baud == ds2480bSET_115200);
+	CHECK(ds2480bOWReset(psDS2480B) == 1);
+	CHECK(ds2480bOWSpeed(psDS2480B, owSPEED_STANDARD) == owSPEED_STANDARD);
+	CHECK(ds2480bOWReset(psDS2480B) == 1);
+	OWP_BusRelease(&sDev.sOW);
+
+	CHECK(psDS2480B->ErrCnt == 0);
+	ds2480bPtyClose();
+	printf("%s (%d failed)\n", Fails ? "FAIL" : "PASS", Fails);
+	return Fails;
+}
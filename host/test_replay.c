@@ -0,0 +1,70 @@
+/*
+ * test_replay.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host: capture a scratchpad read with the transaction trace (ds248xTraceCtrl/Get), replay it
+ * through the simulator (ds248xSimReplay) and check the driver issues the identical transfers.
+ */
+
+#include "hal_platform.h"
+#include "hal_i2c_common.h"
+#include "onewire_platform.h"
+
+#include <string.h>
+
+static int Fails = 0;
+
+#define	CHECK(x)					do { if (!(x)) { printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #x); ++Fails; } } while (0)
+
+/* replay ends (results cleared) before returning, psRes gets them first */
+static int ReadSP(ds18x20_t * psDS18X20, const ds248xtrc_t * psTrc, int Num, ds248xsim_replay_t * psRes) {
+	CHECK(OWP_BusSelect(&psDS18X20->sOW) == 1);
+	if (psTrc)
+		ds248xSimReplay(psTrc, Num);
+	else
+		ds248xTraceCtrl(ds248xTRC_ENA, 0x01, 0xFF, 0);
+	int iRV = ds18x20ReadSP(psDS18X20, 9);
+	if (psTrc) {
+		ds248xSimReplayResult(psRes);
+		ds248xSimReplayReport(NULL);
+		ds248xSimReplay(NULL, 0);
+	} else {
+		ds248xTraceCtrl(0, 0x01, 0xFF, 0);
+	}
+	OWP_BusRelease(&psDS18X20->sOW);
+	return iRV;
+}
+
+int main(void) {
+	static i2c_di_t sI2C = { .Addr = 0x18 };
+	CHECK(ds248xIdentify(&sI2C) == erSUCCESS);
+	CHECK(ds248xConfig(&sI2C) >= erSUCCESS);
+	OWP_Config();
+
+	// capture, must fit the ring without wrapping
+	static ds248xtrc_t sTrc[ds248xTRACE_SIZE];
+	ds18x20_t sDev = psaDS18X20[0];
+	CHECK(ReadSP(&sDev, NULL, 0, NULL) == 1);
+	int Num = ds248xTraceGet(sTrc, ds248xTRACE_SIZE);
+	CHECK(Num > 0 && Num < ds248xTRACE_SIZE && sTrc[0].Seq == 0 && sTrc[Num - 1].Seq == Num - 1);
+
+	// replay of the same operation: lockstep, same result, recorded bus time
+	ds18x20_t sReplay = psaDS18X20[0];
+	sReplay.Tlsb = sReplay.Tmsb = sReplay.Thi = sReplay.Tlo = 0;
+	ds248xsim_replay_t sRes;
+	CHECK(ReadSP(&sReplay, sTrc, Num, &sRes) == 1);
+	CHECK(sRes.Num == Num && sRes.Used == Num && sRes.Diverge == 0 && sRes.First == Num && sRes.Extra == 0);
+	CHECK(sReplay.Tlsb == sDev.Tlsb && sReplay.Tmsb == sDev.Tmsb && sReplay.Thi == sDev.Thi && sReplay.Tlo == sDev.Tlo);
+	u64_t Trec = 0;
+	for (int i = 0; i < Num; Trec += sTrc[i++].Dur);
+	CHECK(sRes.Tbus == Trec * 1000ULL);
+
+	// another device's ROM in the MATCH ROM differs from the record
+	ds18x20_t sOther = psaDS18X20[1];
+	ReadSP(&sOther, sTrc, Num, &sRes);
+	CHECK(sRes.Diverge > 0 && sRes.First < Num);
+
+	// replay ended, the model answers again
+	CHECK(ReadSP(&sOther, NULL, 0, NULL) == 1);
+	printf("%s (%d failed)\n", Fails ? "FAIL" : "PASS", Fails);
+	return Fails;
+}
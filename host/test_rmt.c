@@ -0,0 +1,152 @@
+/*
+ * test_rmt.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host: RMT 1-Wire backend (owb_rmt.c) symbol streams and timing, checked against AN126 table 2
+ * (recommended values) through a device model on the loop back.
+ */
+
+#include "hal_platform.h"
+#include "onewire_platform.h"
+
+#include <string.h>
+
+// ###################################### AN126 table 2 ############################################
+
+enum { tA, tB, tC, tD, tE, tF, tG, tH, tI, tJ, tNUM };
+
+/* uSec x 10 (RMT ticks), [0] standard, [1] overdrive */
+static const u16_t AN126[2][tNUM] = {
+	{ 60, 640, 600, 100, 90, 550,  0, 4800, 700, 4100 },
+	{ 10,  75,  75,  25, 10,  70, 25,  700,  85,  400 },
+};
+
+/* presence pulse, datasheet ranges: high 15-60uS then low 60-240uS (overdrive 2-6uS, 8-24uS) */
+static const u16_t PDH[2] = { 300, 30 }, PDL[2] = { 1200, 120 };
+
+// ###################################### Device model #############################################
+
+#define	GPIO						4
+
+typedef struct line_t {
+	bool Present;
+	u8_t Data[16];							// bits sent in the slots (LSB first), 1 = released
+	int Pos;								// next bit, restarts at a reset
+	u16_t Low0;								// low time of a 0 driven by the device
+	int Short;								// > 0 = receive ends after that many symbols
+	u8_t OD;
+	rmt_symbol_word_t Tx[64];				// last transmit
+	int NumTx;
+} line_t;
+
+static line_t sL;
+
+static int LineModel(void * pvArg, const rmt_symbol_word_t * psTx, int Num, rmt_symbol_word_t * psRx, int Max) {
+	line_t * psL = pvArg;
+	memcpy(psL->Tx, psTx, Num * sizeof(rmt_symbol_word_t));
+	psL->NumTx = Num;
+	if (Num == 1 && psTx[0].duration0 >= AN126[psL->OD][tH]) {		// reset
+		psL->Pos = 0;
+		if (psL->Present == 0) {
+			psRx[0] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = psTx[0].duration0, .level1 = 1 };
+			return 1;
+		}
+		psRx[0] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = psTx[0].duration0, .level1 = 1, .duration1 = PDH[psL->OD] };
+		psRx[1] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = PDL[psL->OD], .level1 = 1 };
+		return 2;
+	}
+	if (psL->Short && Num > psL->Short)
+		Num = psL->Short;
+	for (int i = 0; i < Num && i < Max; ++i, ++psL->Pos) {
+		psRx[i] = psTx[i];
+		bool Bit = (psL->Data[psL->Pos / 8] >> (psL->Pos % 8)) & 1;
+		if (Bit == 0 && psTx[i].duration0 < psL->Low0) {			// device holds the line low
+			psRx[i].duration1 = psTx[i].duration0 + psTx[i].duration1 - psL->Low0;
+			psRx[i].duration0 = psL->Low0;
+		}
+	}
+	psRx[Num - 1].duration1 = 0;										// idle, ends the receive
+	return Num;
+}
+
+static void LineData(u8_t Fill) {
+	memset(sL.Data, Fill, sizeof(sL.Data));
+	sL.Pos = 0;
+}
+
+// ########################################## Tests ################################################
+
+static int Fails = 0;
+
+#define	CHECK(x)					do { if (!(x)) { printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #x); ++Fails; } } while (0)
+
+static bool Slot(int i, u16_t Low, u16_t High) {
+	rmt_symbol_word_t * psS = &sL.Tx[i];
+	return psS->level0 == 0 && psS->duration0 == Low && psS->level1 == 1 && psS->duration1 == High;
+}
+
+static void TestSpeed(owb_rmt_t * psRMT, u8_t OD) {
+	const u16_t * T = AN126[OD];
+	sL.OD = OD;
+	CHECK(rmtOWSpeed(psRMT, OD) == OD);
+
+	// reset: H low, I + J high (master samples presence at H + I), RX idle beyond H
+	sL.Present = 1;
+	CHECK(rmtOWReset(psRMT) == 1);
+	CHECK(sL.NumTx == 1 && Slot(0, T[tH], T[tI] + T[tJ]));
+	CHECK(rmt_host_rx_idle(GPIO) > T[tH] * 100U);
+	sL.Present = 0;
+	CHECK(rmtOWReset(psRMT) == 0);
+
+	// write: 1 = A low B high, 0 = C low D high, LSB first
+	LineData(0xFF);
+	CHECK(rmtOWWriteByte(psRMT, 0xA5) == 0xA5);
+	CHECK(sL.NumTx == 8);
+	for (int i = 0; i < 8; ++i)
+		CHECK((0xA5 >> i) & 1 ? Slot(i, T[tA], T[tB]) : Slot(i, T[tC], T[tD]));
+	CHECK(rmt_host_rx_idle(GPIO) > (u32_t) T[tB] * 100U && rmt_host_rx_idle(GPIO) > (u32_t) T[tC] * 100U);
+
+	// read: write 1 slots, a device 0 holds the line low past the sample point A + E
+	LineData(0x3C);
+	sL.Low0 = T[tA] + T[tE];
+	CHECK(rmtOWReadByte(psRMT) == 0x3C);
+	for (int i = 0; i < 8; ++i)
+		CHECK(Slot(i, T[tA], T[tB]));
+	LineData(0x00);
+	sL.Low0 = T[tA] + T[tE] - 1;					// released before the sample point
+	CHECK(rmtOWReadByte(psRMT) == 0xFF);
+}
+
+int main(void) {
+	CHECK(rmtOWConfig() == 1);
+	owb_rmt_t * psRMT = &psaRMT[0];
+	CHECK(psRMT->Gpio == GPIO);
+	CHECK(rmt_host_line(GPIO, LineModel, &sL) == ESP_OK);
+
+	TestSpeed(psRMT, owSPEED_ODRIVE);
+	TestSpeed(psRMT, owSPEED_STANDARD);
+
+	// blocks are batched in whole bytes, rmtOW_BATCH_BYTES per transmit
+	u8_t Blk[2 * rmtOW_BATCH_BYTES], Chk[sizeof(Blk)];
+	for (int i = 0; i < sizeof(Blk); ++i)
+		Blk[i] = 0x11 * i;
+	LineData(0xFF);
+	u32_t Cnt = rmt_host_transmits(GPIO);
+	rmtOWWriteBlock(psRMT, Blk, sizeof(Blk));
+	CHECK(rmt_host_transmits(GPIO) - Cnt == 2);
+	CHECK(sL.NumTx == rmtOW_BATCH_BYTES * 8 && sL.NumTx <= rmtOW_BATCH_BITS);
+
+	memcpy(sL.Data, Blk, sizeof(Blk));
+	sL.Pos = 0;
+	sL.Low0 = AN126[0][tA] + AN126[0][tE];
+	rmtOWReadBlock(psRMT, Chk, sizeof(Chk));
+	CHECK(memcmp(Chk, Blk, sizeof(Blk)) == 0);
+
+	// slots missing from the receive read as 0
+	LineData(0xFF);
+	sL.Short = 4;
+	CHECK(rmtOWReadByte(psRMT) == 0x0F);
+	sL.Short = 0;
+
+	printf("%s (%d failed)\n", Fails ? "FAIL" : "PASS", Fails);
+	return Fails;
+}
@@ -0,0 +1,145 @@
+/*
+ * test_sim.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Host: boot the component on a simulated DS2482-800 (2x DS18B20 per channel), check the
+ * enumeration & its order, probe bus READ ROM, tag events, scratchpad access, channel select and the bus-time model.
+ */
+
+#include "hal_platform.h"
+#include "hal_i2c_common.h"
+#include "onewire_platform.h"
+
+#include <string.h>
+
+extern u8_t Fam10Count, Fam28Count, Fam10_28Count;
+
+static int Fails = 0;
+
+#define	CHECK(x)					do { if (!(x)) { printf("FAIL %s:%d %s\n", __FILE__, __LINE__, #x); ++Fails; } } while (0)
+
+static u64_t LastROM;
+
+static int CountCB(report_t * psR, owdi_t * psOW) {
+	LastROM = psOW->ROM.Value;
+	return 1;
+}
+
+int main(void) {
+	static i2c_di_t sI2C = { .Addr = 0x18 };
+	CHECK(ds248xIdentify(&sI2C) == erSUCCESS);
+	CHECK(ds248xConfig(&sI2C) >= erSUCCESS);
+	// a DS18S20 found after the DS18B20 of channel 0 (search order) on a later channel
+	ow_rom_t sS20ROM = { .FAM = OWFAMILY_10, .TAG = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7F } };
+	sS20ROM.CRC = OWCalcCRC8(sS20ROM.HexChars, 7);
+	CHECK(ds248xSimAttach(0, 3, sS20ROM.Value) == erSUCCESS);
+	ds248xSimClear();
+	OWP_Config();
+	CHECK(Fam28Count == 16 && Fam10Count == 1);
+
+	// enumerated in bus order, numbered in that order
+	int S20 = -1;
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		CHECK(psaDS18X20[i].sEWx.idx == i);
+		if (i)
+			CHECK(psaDS18X20[i-1].sOW.PhyBus <= psaDS18X20[i].sOW.PhyBus);
+		if (psaDS18X20[i].sOW.ROM.Value == sS20ROM.Value)
+			S20 = i;
+	}
+	CHECK(S20 >= 0 && psaDS18X20[S20].sOW.PhyBus == 3);
+	CHECK(ds248xSimDetach(0, 3, sS20ROM.Value) == erSUCCESS);
+
+	ds248xsim_stat_t sStat;
+	ds248xSimStats(0, &sStat);
+	CHECK(sStat.Xfers > 0 && sStat.Resets > 0 && sStat.Slots > 0 && sStat.Tbus > 0);
+
+	ds18x20_t * psDS18X20 = &psaDS18X20[0];
+	CHECK(OWP_BusSelect(&psDS18X20->sOW) == 1);
+	CHECK(ds18x20ReadSP(psDS18X20, 9) == 1);
+	OWP_BusRelease(&psDS18X20->sOW);
+	CHECK(psDS18X20->Tlsb == 0x90 && psDS18X20->Tmsb == 0x01);	// 25C at boot
+
+	ds248xsim_stat_t sNext;
+	ds248xSimStats(0, &sNext);
+	CHECK(sNext.Tbus > sStat.Tbus);
+
+	// DS18S20 scratchpad write is TH & TL only
+	ow_rom_t sROM = { .FAM = OWFAMILY_10, .TAG = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 } };
+	sROM.CRC = OWCalcCRC8(sROM.HexChars, 7);
+	CHECK(ds248xSimAttach(0, 0, sROM.Value) == erSUCCESS);
+	ds18x20_t sS20 = psaDS18X20[0];
+	sS20.sOW.ROM = sROM;
+	sS20.Thi = 0x55;
+	sS20.Tlo = 0x11;
+	CHECK(OWP_BusSelect(&sS20.sOW) == 1);
+	CHECK(ds18x20WriteSP(&sS20) == 1);
+	sS20.Thi = sS20.Tlo = 0;
+	CHECK(ds18x20ReadSP(&sS20, 9) == 1);
+	OWP_BusRelease(&sS20.sOW);
+	CHECK(sS20.Thi == 0x55 && sS20.Tlo == 0x11);
+	CHECK(ds248xSimDetach(0, 0, sROM.Value) == erSUCCESS);
+
+	// DS2482-800 channel select accepts the 8 channel codes only
+	u8_t Tx[2] = { ds2482CMD_CHSL, 0xE1 }, Rx;
+	CHECK(ds248xSimXfer(&sI2C, Tx, 2, &Rx, 1) == erSUCCESS && Rx == 0xB1);
+	Tx[1] = 0xFF;
+	CHECK(ds248xSimXfer(&sI2C, Tx, 2, &Rx, 1) == erFAILURE);
+	Tx[1] = 0x96;
+	CHECK(ds248xSimXfer(&sI2C, Tx, 2, &Rx, 1) == erSUCCESS && Rx == 0x8E);
+
+	// probe bus (channel 6 emptied, as if nothing answered at boot): a wired-AND READ ROM of 2
+	// tags passes the CRC when one ROM's 1 bits are a subset of the other's, both must be found
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		if (psaDS18X20[i].sOW.PhyBus == 6)
+			CHECK(ds248xSimDetach(0, 6, psaDS18X20[i].sOW.ROM.Value) == erSUCCESS);
+	}
+	u8_t LogBus = psaDS248X[0].Lo + 6;
+	psOWP_BusGetPointer(LogBus)->NumDev = 0;
+	ow_rom_t sA = { .FAM = OWFAMILY_01 }, sB = sA;
+	for (int i = 1; i < 256 && sB.Value == sA.Value; ++i) {
+		sA.TAG[0] = i;
+		sA.CRC = OWCalcCRC8(sA.HexChars, 7);
+		for (int j = 1; j < 256; ++j) {
+			sB = sA;
+			sB.TAG[1] = j;
+			sB.CRC = OWCalcCRC8(sB.HexChars, 7);
+			if ((sA.CRC & sB.CRC) == sA.CRC)
+				break;
+			sB = sA;
+		}
+	}
+	CHECK(sB.Value != sA.Value && (sA.Value & sB.Value) == sA.Value);
+	CHECK(ds248xSimAttach(0, 6, sA.Value) == erSUCCESS);
+	CHECK(OWP_ScanBus(LogBus, 0, CountCB) == 1 && LastROM == sA.Value);
+	CHECK(ds248xSimAttach(0, 6, sB.Value) == erSUCCESS);
+	CHECK(OWP_ScanBus(LogBus, 0, CountCB) == 2);
+	CHECK(ds248xSimDetach(0, 6, sA.Value) == erSUCCESS);
+	CHECK(OWP_ScanBus(LogBus, 0, CountCB) == 1 && LastROM == sB.Value);
+	CHECK(ds248xSimDetach(0, 6, sB.Value) == erSUCCESS);
+	CHECK(OWP_ScanBus(LogBus, 0, CountCB) == 0);
+
+	// tag events: none queued without a subscriber, then a single notification for 2 reads
+	ds1990xevt_t sEvt[4];
+	CHECK(ds248xSimAttach(0, 6, sA.Value) == erSUCCESS);
+	CHECK(ds1990Sense(&table_work[URI_DS1990X]) == erSUCCESS);
+	CHECK(ds1990xEventGet(sEvt, 4) == 0 && ds1990xEventLost() == 0);
+	CHECK(ds248xSimDetach(0, 6, sA.Value) == erSUCCESS);
+	ds1990xEventSubscribe(xTaskGetCurrentTaskHandle());
+	ulTaskNotifyTake(pdTRUE, 0);
+	ow_rom_t sC = sA, sD = sB;
+	sC.TAG[2] = sD.TAG[2] = 0x5A;					// new tags, not repeats
+	sC.CRC = OWCalcCRC8(sC.HexChars, 7);
+	sD.CRC = OWCalcCRC8(sD.HexChars, 7);
+	CHECK(ds248xSimAttach(0, 6, sC.Value) == erSUCCESS);
+	CHECK(ds248xSimAttach(0, 6, sD.Value) == erSUCCESS);
+	vTaskDelay(pdMS_TO_TICKS(100));						// channel due again
+	CHECK(ds1990Sense(&table_work[URI_DS1990X]) == erSUCCESS);
+	CHECK(ulTaskNotifyTake(pdTRUE, 0) == (1UL << (LogBus + evtFIRST_OW)));
+	CHECK(ds1990xEventGet(sEvt, 4) == 2 && sEvt[0].LogChan == LogBus && sEvt[1].Seq == sEvt[0].Seq + 1);
+	CHECK(ds1990xEventGet(sEvt, 4) == 0);
+	ds1990xEventSubscribe(NULL);
+	CHECK(ds248xSimDetach(0, 6, sC.Value) == erSUCCESS);
+	CHECK(ds248xSimDetach(0, 6, sD.Value) == erSUCCESS);
+
+	printf("%s (%d failed)\n", Fails ? "FAIL" : "PASS", Fails);
+	return Fails;
+}
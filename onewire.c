@@ -31,6 +31,41 @@
  *	Duration	525nS	0nS		0nS		0nS		1244uS	8x73uS	8x73uS	1x73uS	3x73uS
  */
 
+// ####################################### Backend routing #########################################
+
+const ow_ops_t * const owOps[owBUS_NUM] = {
+	#if (HAL_DS248X > 0)
+	[owBUS_DS248x] = &ds248xOps,
+	#endif
+	#if (halRMT_1W > 0)
+	[owBUS_RMT] = &rmtOps,
+	#endif
+	#if (HAL_DS2480B > 0)
+	[owBUS_DS2480B] = &ds2480bOps,
+	#endif
+};
+
+#define	OWOPS(psOW)		(owOps[(psOW)->Type])
+
+/**
+ * @brief	Search triplet (2 bit reads & 1 bit write) for backends without hardware support
+ * @return	owTRIP_? bits
+ */
+static u8_t OWTripletSW(owdi_t * psOW, u8_t Dir) {
+	const ow_ops_t * psOps = OWOPS(psOW);
+	bool Id = psOps->TouchBit(psOW->DevNum, 1);
+	bool Cmp = psOps->TouchBit(psOW->DevNum, 1);
+	if (Id != Cmp)										// all devices agree, take their bit
+		Dir = Id;
+	psOps->TouchBit(psOW->DevNum, Dir);
+	return (Id ? owTRIP_ID : 0) | (Cmp ? owTRIP_CMP : 0) | (Dir ? owTRIP_DIR : 0);
+}
+
+static u8_t OWTriplet(owdi_t * psOW, u8_t Dir) {
+	const ow_ops_t * psOps = OWOPS(psOW);
+	return psOps->Triplet ? psOps->Triplet(psOW->DevNum, Dir) : OWTripletSW(psOW, Dir);
+}
+
 // ################################# Basic 1-Wire operations #######################################
 
 /**
@@ -39,7 +74,7 @@
  *			0 if no presence pulse(s) detected
  */
 int OWReset(owdi_t * psOW) {
-	return ds248xOWReset(&psaDS248X[psOW->DevNum]);
+	return OWOPS(psOW)->Reset(psOW->DevNum);
 }
 
 // ############################### Bit/Byte/Block Read/Write #######################################
@@ -50,13 +85,13 @@ int OWReset(owdi_t * psOW) {
  *
  * 'sendbit' - 1 bit to send (least significant byte)
  */
-void OWWriteBit(owdi_t * psOW, bool Bit) { ds248xOWTouchBit(&psaDS248X[psOW->DevNum], Bit); }
+void OWWriteBit(owdi_t * psOW, bool Bit) { OWOPS(psOW)->TouchBit(psOW->DevNum, Bit); }
 
 /**
  * @brief	Read 1 bit of communication from the 1-Wire Net and return the result
  * @return	1 bit read from 1-Wire Net
  */
-bool OWReadBit(owdi_t * psOW) { return ds248xOWTouchBit(&psaDS248X[psOW->DevNum], 1) ; }
+bool OWReadBit(owdi_t * psOW) { return OWOPS(psOW)->TouchBit(psOW->DevNum, 1) ; }
 
 /**
  * @brief	Send 8 bits of communication to the 1-Wire Net and verify that the
@@ -66,21 +101,27 @@ bool OWReadBit(owdi_t * psOW) { return ds248xOWTouchBit(&psaDS248X[psOW->DevNum]
  * @return	status register value after write
  */
 u8_t OWWriteByte(owdi_t * psOW, u8_t Byte) {
-	return ds248xOWWriteByte(&psaDS248X[psOW->DevNum], Byte);
+	return OWOPS(psOW)->WriteByte(psOW->DevNum, Byte);
 }
 
 /**
  * @brief	Reads 8 bits of communication from the 1-Wire Net
  * @return	8 bits read from 1-Wire Net
  */
-u8_t OWReadByte(owdi_t * psOW) { return ds248xOWReadByte(&psaDS248X[psOW->DevNum]) ; }
+u8_t OWReadByte(owdi_t * psOW) { return OWOPS(psOW)->ReadByte(psOW->DevNum) ; }
 
 void OWWriteBlock(owdi_t * psOW, u8_t * pBuf, int Len) {
-	for (int i = 0; i < Len; OWWriteByte(psOW, pBuf[i++])) ;
+	if (OWOPS(psOW)->WriteBlock)
+		OWOPS(psOW)->WriteBlock(psOW->DevNum, pBuf, Len);
+	else
+		for (int i = 0; i < Len; OWWriteByte(psOW, pBuf[i++])) ;
 }
 
 void OWReadBlock(owdi_t * psOW, u8_t * pBuf, int Len) {
-	for (int i = 0; i < Len; pBuf[i++] = OWReadByte(psOW)) ;
+	if (OWOPS(psOW)->ReadBlock)
+		OWOPS(psOW)->ReadBlock(psOW->DevNum, pBuf, Len);
+	else
+		for (int i = 0; i < Len; pBuf[i++] = OWReadByte(psOW)) ;
 }
 
 // ############################## Search and Variations thereof ####################################
@@ -147,7 +188,20 @@ int OWSearch(owdi_t * psOW, bool alarm_only) {
 			return 0;
 		}
 		OWWriteByte(psOW, alarm_only ? OW_CMD_SEARCHALARM : OW_CMD_SEARCHROM);
-		do {
+		if (OWOPS(psOW)->Search) {						// accelerator, 64 triplets in 1 exchange
+			u64_t Disc = 0;
+			if (OWOPS(psOW)->Search(psOW->DevNum, psOW->LD, &psOW->ROM, &Disc) == 1) {
+				for (int i = 0; i < 64; ++i) {
+					if (Disc & (1ULL << i)) {
+						LastZero = i + 1;
+						if (LastZero < 9)
+							psOW->LFD = LastZero;
+					}
+				}
+				BitNum = 65;
+				crc8 = OWCalcCRC8(psOW->ROM.HexChars, sizeof(ow_rom_t));
+			}
+		} else do {
 		// if this discrepancy is before the Last Discrepancy
 		// on a previous next then pick the same as last time
 			if (BitNum < psOW->LD) {
@@ -155,10 +209,10 @@ int OWSearch(owdi_t * psOW, bool alarm_only) {
 			} else {									// if equal to last pick 1, if not then pick 0
 				u8SrcDir = (BitNum == psOW->LD) ? 1 : 0;
 			}
-			u8Status = ds248xOWSearchTriplet(&psaDS248X[psOW->DevNum], u8SrcDir) ;
-			s8_t i8IdBit = ((u8Status & ds248xSTAT_SBR) == ds248xSTAT_SBR);
-			s8_t i8IdBitCmp	= ((u8Status & ds248xSTAT_TSB) == ds248xSTAT_TSB);
-			u8SrcDir = ((u8Status & ds248xSTAT_DIR) == ds248xSTAT_DIR) ? 1 : 0 ;
+			u8Status = OWTriplet(psOW, u8SrcDir) ;		// hardware or software
+			s8_t i8IdBit = (u8Status & owTRIP_ID) ? 1 : 0;
+			s8_t i8IdBitCmp	= (u8Status & owTRIP_CMP) ? 1 : 0;
+			u8SrcDir = (u8Status & owTRIP_DIR) ? 1 : 0 ;
 			if (i8IdBit && i8IdBitCmp) {				// check for no devices on 1-Wire
 				break ;
 			} else {
@@ -226,7 +280,9 @@ int OWNext(owdi_t * psOW, bool alarm_only) { return OWSearch(psOW, alarm_only) ;
  * @param	speed - owSPEED_STANDARD or owSPEED_OVERDRIVE
  * @return	new current 1W speed (0 = Standard, 1= Overdrive)
  */
-int	OWSpeed(owdi_t * psOW, bool Spd) { return ds248xOWSpeed(&psaDS248X[psOW->DevNum], Spd) ; }
+int	OWSpeed(owdi_t * psOW, bool Spd) {
+	return OWOPS(psOW)->Speed ? OWOPS(psOW)->Speed(psOW->DevNum, Spd) : owSPEED_STANDARD;
+}
 
 /**
  * Set the 1-Wire Net line level pull-up to normal.
@@ -235,7 +291,9 @@ int	OWSpeed(owdi_t * psOW, bool Spd) { return ds248xOWSpeed(&psaDS248X[psOW->Dev
  *		STRONG		1
  * Returns:  current 1-Wire Net level
  */
-int	OWLevel(owdi_t * psOW, bool Pwr) { return ds248xOWLevel(&psaDS248X[psOW->DevNum], Pwr) ; }
+int	OWLevel(owdi_t * psOW, bool Pwr) {
+	return OWOPS(psOW)->Level ? OWOPS(psOW)->Level(psOW->DevNum, Pwr) : owPOWER_STANDARD;
+}
 
 /**
  * OWCheckCRC() - Checks if CRC is ok (ROM Code or Scratch PAD RAM)
@@ -261,15 +319,27 @@ u8_t OWCheckCRC(u8_t * buf, u8_t buflen) {
 }
 
 /**
- * OWReadROM() - Check PPD, send command and loop for 8byte read
+ * @brief	Calculate CRC8 over a buffer, without reporting, for use where a failure is expected
+ * @return	CRC value, 0 if buffer (including trailing CRC byte) is valid
+ */
+u8_t OWCalcCRC8(u8_t * buf, u8_t buflen) {
+	u8_t crc8 = 0;
+	for (int i = 0; i < buflen; ++i)
+		crc8 = OWUpdateCRC8(crc8, buf[i]);
+	return crc8;
+}
+
+/**
+ * OWReadROM() - Send command and loop for 8byte read, bus must have been reset (PPD) by caller
  * @brief	To be used if only a single device on a bus and the ROM ID must be read
- * 			Probably will fail if more than 1 device on the bus
- * @return	erFAILURE or CRC byte
+ * 			If more than 1 device responds the wired-AND result will (almost always) fail CRC
+ * @return	1 if a valid ROM read, 0 if CRC error (collision or corruption) or all zero ROM
+ * @note	CRC failure NOT reported, caller decides if a search must resolve the collision
  */
 int	OWReadROM(owdi_t * psOW) {
 	OWWriteByte(psOW, OW_CMD_READROM);
 	OWReadBlock(psOW, psOW->ROM.HexChars, sizeof(ow_rom_t));
-	return OWCheckCRC(psOW->ROM.HexChars, sizeof(ow_rom_t));
+	return (OWCalcCRC8(psOW->ROM.HexChars, sizeof(ow_rom_t)) == 0) && psOW->ROM.HexChars[owFAMILY];
 }
 
 /**
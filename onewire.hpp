@@ -0,0 +1,219 @@
+// onewire.hpp - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+
+/* Header only C++ layer over the 1-Wire C API, for C++ application code.
+ * Everything here is inline and forwards to the same C functions a C caller would use, there is
+ * no state beyond the C structures themselves and no virtual dispatch.
+ *	BusGuard	- RAII OWP_BusSelect()/OWP_BusRelease() pairing, released on every return path
+ *	Rom/Family/Bus - strongly typed ROM, family code & logical bus handles
+ *	FamilyTraits<F> - constexpr per family scratchpad length, CRC kind, raw units & conversion timing
+ *	Ds18x20<F>, Ds1990x - device classes, bus operations take the BusGuard of the device's own bus
+ *				  so they cannot be called without it being held (asserted, false if not)
+ */
+
+#pragma once
+
+#include "onewire_platform.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+namespace ow {
+
+// ####################################### Strong handles ##########################################
+
+class Family {
+public:
+	constexpr explicit Family(u8_t Code) : Code(Code) {}
+	constexpr u8_t code() const { return Code; }
+	constexpr bool operator==(Family o) const { return Code == o.Code; }
+	constexpr bool operator!=(Family o) const { return Code != o.Code; }
+private:
+	u8_t Code;
+};
+
+class Rom {
+public:
+	constexpr explicit Rom(u64_t Value) : Value(Value) {}
+	explicit Rom(const ow_rom_t & sROM) : Value(sROM.Value) {}
+	constexpr u64_t value() const { return Value; }
+	constexpr Family family() const { return Family(Value & 0xFF); }	// ow_rom_t.FAM, low byte
+	/**
+	 * @brief	Same Dallas CRC8 as OWCheckCRC(), CRC of all 8 bytes is 0 if valid
+	 */
+	constexpr bool valid() const {
+		u8_t Crc = 0;
+		for (int i = 0; i < 64; ++i) {
+			bool Fb = ((Value >> i) ^ Crc) & 0x01;
+			Crc >>= 1;
+			if (Fb)
+				Crc ^= 0x8C;
+		}
+		return Crc == 0 && Value != 0;
+	}
+	const owdh_t * find() const { return psOWP_DevFind(Value); }	// NULL if not enumerated
+	constexpr bool operator==(Rom o) const { return Value == o.Value; }
+	constexpr bool operator!=(Rom o) const { return Value != o.Value; }
+private:
+	u64_t Value;
+};
+
+class Bus {
+public:
+	constexpr explicit Bus(u8_t LogBus) : LogBus(LogBus) {}
+	explicit Bus(owdi_t & sOW) : LogBus(OWP_BusP2L(&sOW)) {}
+	constexpr u8_t logical() const { return LogBus; }
+	static int count() { return OWP_NumBusGet(); }
+	owbi_t * info() const { return psOWP_BusGetPointer(LogBus); }
+	void map(owdi_t & sOW) const { OWP_BusL2P(&sOW, LogBus); }		// physical address into sOW
+	owdh_t * devices(u8_t & Num) const { return psOWP_BusDevs(LogBus, &Num); }
+	int scan(u8_t Family, int (* Handler)(struct report_t *, owdi_t *)) const {
+		return OWP_ScanBus(LogBus, Family, Handler);
+	}
+private:
+	u8_t LogBus;
+};
+
+// ######################################### Bus guard #############################################
+
+/* Owns the bus lock from a successful select to destruction (or release()). A failed select
+ * leaves nothing to release, test the guard before using the bus. A failed yield() still holds
+ * the lock (see ds248xBusYield), only the channel may no longer be selected. The arbitration class
+ * lives in the guard's own copy of the device, the owner's owdi_t (device()) is never written. */
+class BusGuard {
+public:
+	explicit BusGuard(owdi_t & sOW) : BusGuard(sOW, sOW.Pri) {}	// sOW.Pri as set by the owner
+	BusGuard(owdi_t & sOW, u8_t Pri) : sSel(sOW), psOW(&sOW), Held(false) {
+		assert(Pri < owPRI_NUM);
+		sSel.Pri = Pri;									// owPRI_? arbitration class
+		Held = (OWP_BusSelect(&sSel) == 1);
+	}
+	~BusGuard() { release(); }
+	BusGuard(const BusGuard &) = delete;
+	BusGuard & operator=(const BusGuard &) = delete;
+	BusGuard(BusGuard && o) noexcept : sSel(o.sSel), psOW(o.psOW), Held(o.Held) { o.Held = false; }
+	BusGuard & operator=(BusGuard &&) = delete;
+
+	explicit operator bool() const { return Held; }
+	owdi_t & device() const { return *psOW; }
+	bool yield() { return Held && OWP_BusYield(&sSel) == 1; }	// 1 = still selected
+	void release() {
+		if (Held)
+			OWP_BusRelease(&sSel);
+		Held = false;
+	}
+	int reset() { return OWReset(psOW); }				// 1 = presence detected
+	int command(u8_t Cmd, bool Skip, bool Pwr = false) { return OWResetCommand(psOW, Cmd, Skip, Pwr); }
+	int addrMode() const { return OWP_BusAddrMode(psOW); }
+	void write(u8_t * pBuf, int Len) { OWWriteBlock(psOW, pBuf, Len); }
+	void read(u8_t * pBuf, int Len) { OWReadBlock(psOW, pBuf, Len); }
+	int level(bool Pwr) { return OWLevel(psOW, Pwr); }
+private:
+	owdi_t sSel;										// select/yield/release, with Pri
+	owdi_t * psOW;										// the owner's, bus operations & owns()
+	bool Held;
+};
+
+// ####################################### Family traits ###########################################
+
+enum class Crc : u8_t { None, Crc8, Crc16 };
+
+template <u8_t F> struct FamilyTraits {
+	static constexpr bool Known = false;
+};
+
+template <> struct FamilyTraits<OWFAMILY_01> {			// DS1990A/R, ROM only
+	static constexpr bool Known = true;
+	static constexpr u8_t SpadLen = 0;
+	static constexpr Crc SpadCrc = Crc::None;
+	static constexpr u32_t tConvert(u8_t) { return 0; }
+};
+
+template <> struct FamilyTraits<OWFAMILY_10> {			// DS18S20, fixed 9 bit (+ Count_Remain)
+	static constexpr bool Known = true;
+	static constexpr u8_t SpadLen = 9;
+	static constexpr Crc SpadCrc = Crc::Crc8;
+	static constexpr int RawDiv = 2;					// 1/2 C per LSB, as ds18x20RAW_DIV()
+	static constexpr u8_t rawMask(u8_t) { return 0xFF; }
+	static constexpr u32_t tConvert(u8_t) { return 750; }	// mSec, max
+};
+
+template <> struct FamilyTraits<OWFAMILY_28> {			// DS18B20, 9 -> 12 bit
+	static constexpr bool Known = true;
+	static constexpr u8_t SpadLen = 9;
+	static constexpr Crc SpadCrc = Crc::Crc8;
+	static constexpr int RawDiv = 16;					// 1/16 C per LSB, as ds18x20RAW_DIV()
+	static constexpr u8_t rawMask(u8_t Res) { return 0xFF << (owFAM28_RES12B - Res); }	// undefined LSBs
+	static constexpr u32_t tConvert(u8_t Res) { return 750 >> (owFAM28_RES12B - Res); }	// 93/187/375/750 mSec
+};
+
+static_assert(FamilyTraits<OWFAMILY_28>::tConvert(owFAM28_RES9B) == 93, "DS18B20 9 bit convert");
+static_assert(FamilyTraits<OWFAMILY_28>::rawMask(owFAM28_RES9B) == 0xF8, "DS18B20 9 bit mask");
+static_assert(sizeof(((ds18x20_t *) 0)->RegX) == FamilyTraits<OWFAMILY_28>::SpadLen, "scratchpad");
+
+// ###################################### Device classes ###########################################
+
+#if (HAL_DS18X20 > 0)
+template <u8_t F> class Ds18x20 {
+	static_assert(F == OWFAMILY_10 || F == OWFAMILY_28, "not a DS18x20 family");
+public:
+	using Traits = FamilyTraits<F>;
+	explicit Ds18x20(ds18x20_t & sDev) : psDev(&sDev) {}	// sDev.sOW.ROM.FAM must be F
+	explicit Ds18x20(const owdh_t & sDH) : Ds18x20(psaDS18X20[sDH.Slot]) {}
+
+	ds18x20_t & raw() const { return *psDev; }
+	owdi_t & ow() const { return psDev->sOW; }
+	Rom rom() const { return Rom(psDev->sOW.ROM); }
+	Bus bus() const { return Bus(psDev->sOW); }
+	BusGuard select(u8_t Pri = owPRI_PERIODIC) const { return BusGuard(psDev->sOW, Pri); }
+	u32_t tConvert() const { return Traits::tConvert(F == OWFAMILY_28 ? psDev->Res : 0); }
+
+	bool readTemp(BusGuard & g) { return owns(g) && ds18x20ReadSP(psDev, 2) != 0; }	// Tlsb/Tmsb only
+	bool readSP(BusGuard & g) { return owns(g) && ds18x20ReadSP(psDev, Traits::SpadLen) != 0; }	// CRC checked
+	bool writeSP(BusGuard & g) { return owns(g) && ds18x20WriteSP(psDev) != 0; }
+	bool writeEE(BusGuard & g) { return owns(g) && ds18x20WriteEE(psDev) != 0; }
+	bool checkPower(BusGuard & g) { return owns(g) && ds18x20CheckPower(psDev); }
+	/**
+	 * @brief	Last RAM sample, raw: divide by Traits::RawDiv for degrees C
+	 * @note	DS18B20 LSBs undefined at the configured resolution are masked, as the C API does
+	 */
+	i16_t sample() const { return (i16_t) ((psDev->Tmsb << 8) | (psDev->Tlsb & Traits::rawMask(psDev->Res))); }
+	float celsius() const { return (float) sample() / Traits::RawDiv; }
+	/**
+	 * @brief	Cached read, see ds18x20ReadCached(), takes & releases the bus itself
+	 * @param	Raw - same units as sample()
+	 */
+	int readCached(u32_t MaxAge, i16_t & Raw) const {
+		return ds18x20ReadCached(psDev - psaDS18X20, MaxAge, &Raw);
+	}
+private:
+	bool owns(const BusGuard & g) const {				// held, and for THIS sensor's bus
+		bool Ok = g && &g.device() == &psDev->sOW;
+		assert(Ok);
+		return Ok;
+	}
+	ds18x20_t * psDev;
+};
+
+using Ds18s20 = Ds18x20<OWFAMILY_10>;
+using Ds18b20 = Ds18x20<OWFAMILY_28>;
+#endif
+
+#if (HAL_DS1990X > 0)
+class Ds1990x {
+public:
+	using Traits = FamilyTraits<OWFAMILY_01>;
+	explicit Ds1990x(owdi_t & sOW) : psOW(&sOW) {}
+	Rom rom() const { return Rom(psOW->ROM); }
+	BusGuard select(u8_t Pri = owPRI_INTERACTIVE) const { return BusGuard(*psOW, Pri); }
+	bool readROM(BusGuard & g) {						// sole device on the bus
+		bool Ok = g && &g.device() == psOW;
+		assert(Ok);
+		return Ok && OWReadROM(psOW) != 0;
+	}
+	bool authorised() const { return ds1990xAuthCheck(psOW->ROM.Value) == ds1990xAUTH_ALLOW; }
+private:
+	owdi_t * psOW;
+};
+#endif
+
+}	// namespace ow
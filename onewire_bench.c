@@ -0,0 +1,236 @@
+/*
+ * onewire_bench.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * End-to-end 1-Wire benchmark scenarios, run against the DS248x simulator (ds248xSIMULATE) so the
+ * transaction count and simulated bus time are deterministic from one build to the next.
+ * Output is one CSV line per scenario:
+ *	bench,<name>,<items>,<xfers>,<bus_uS>,<wall_uS>,<base_xfers>,<base_bus_uS>,<PASS|FAIL|NEW>
+ * A scenario FAILs when xfers or bus time exceed its baseline by more than onewireBENCH_TOL %.
+ * Baselines are only valid for the population they were recorded on, a scenario handling a
+ * different number of items than its baseline is not compared (NEW).
+ * Scenarios run against the live (simulated) population, the sensor schedule & configuration they
+ * change is saved before and put back after each one, outside the measurement.
+ * Only transfers done for the calling task are counted, background sense & poll passes running at
+ * the same time share the buses (wall time) but not the statistics.
+ */
+
+#include "hal_platform.h"
+
+#if (HAL_ONEWIRE > 0) && (onewireBENCH > 0)
+#include "onewire_platform.h"
+#include "report.h"
+#include "syslog.h"
+#include "errors_events.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if (HAL_DS248X == 0) || (ds248xSIMULATE == 0)
+	#error "onewireBENCH requires HAL_DS248X with ds248xSIMULATE"
+#endif
+
+// ###################################### General macros ###########################################
+
+#define	debugFLAG					0xF000
+
+#define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
+#define	debugTRACK					(debugFLAG_GLOBAL & debugFLAG & 0x2000)
+#define	debugPARAM					(debugFLAG_GLOBAL & debugFLAG & 0x4000)
+#define	debugRESULT					(debugFLAG_GLOBAL & debugFLAG & 0x8000)
+
+// ######################################## Build macros ###########################################
+
+#ifndef onewireBENCH_TOL
+	#define	onewireBENCH_TOL		5				// % allowed over baseline before FAIL
+#endif
+
+#define	onewireBENCH_DENSE			8				// devices added for the dense search tree
+
+// ##################################### Local structures ##########################################
+
+enum { benchSAVE_SCHED = 1 << 0, benchSAVE_CONF = 1 << 1 };	// live DS18x20 state a scenario changes
+
+typedef struct ow_bench_t {
+	const char * pcName;
+	int (* Run)(void);								// returns items handled or erXXX
+	u8_t Save;										// benchSAVE_? restored after the run
+	int Items;										// baseline population
+	u32_t Xfers;									// baseline
+	u32_t Tbus;										// baseline, uSec
+} ow_bench_t;
+
+#if (HAL_DS18X20 > 0)
+typedef struct ow_bench_save_t {					// per sensor
+	TickType_t Tdue;
+	u8_t Due, Res;
+	u8_t Thi, Tlo, Conf;
+} ow_bench_save_t;
+#endif
+
+// ################################### Scenario support ############################################
+
+extern u8_t ds248xCount;
+extern u8_t Fam10_28Count;
+
+static int OWP_BenchCB(report_t * psR, owdi_t * psOW) { return 1; }
+
+/**
+ * @brief	ROM on the benchmark bus, same family & upper bytes so the search tree is dense
+ */
+static u64_t OWP_BenchROM(u8_t Family, u8_t Idx) {
+	ow_rom_t sROM = { .FAM = Family, .TAG = { Idx, 0x00, 0x00, 0xBE, 0xBE, 0x00 } };
+	sROM.CRC = OWCalcCRC8(sROM.HexChars, 7);
+	return sROM.Value;
+}
+
+static void OWP_BenchStats(ds248xsim_stat_t * psSum) {
+	memset(psSum, 0, sizeof(ds248xsim_stat_t));
+	for (int i = 0; i < ds248xCount; ++i) {
+		ds248xsim_stat_t sStat;
+		ds248xSimStats(i, &sStat);
+		psSum->Xfers += sStat.Xfers;
+		psSum->Tbus += sStat.Tbus;
+	}
+}
+
+static u8_t OWP_BenchPhyBus(void) { return psaDS248X[0].NumChan ? 7 : 0; }
+
+#if (HAL_DS18X20 > 0)
+static ow_bench_save_t * OWP_BenchSave(void) {
+	ow_bench_save_t * psSave = malloc(Fam10_28Count * sizeof(ow_bench_save_t));
+	for (int i = 0; psSave && i < Fam10_28Count; ++i) {
+		ds18x20_t * psX = &psaDS18X20[i];
+		psSave[i] = (ow_bench_save_t) { .Tdue = psX->Tdue, .Due = psX->Due, .Res = psX->Res,
+			.Thi = psX->Thi, .Tlo = psX->Tlo, .Conf = psX->fam28.Conf };
+	}
+	return psSave;
+}
+
+/**
+ * @brief	Put back the schedule and/or configuration, changed scratchpads are rewritten (RAM only)
+ */
+static void OWP_BenchRestore(ow_bench_save_t * psSave, u8_t Save) {
+	for (int i = 0; i < Fam10_28Count; ++i) {
+		ds18x20_t * psX = &psaDS18X20[i];
+		if (Save & benchSAVE_SCHED) {
+			psX->Tdue = psSave[i].Tdue;
+			psX->Due = psSave[i].Due;
+		}
+		if ((Save & benchSAVE_CONF) && (psX->Thi != psSave[i].Thi || psX->Tlo != psSave[i].Tlo ||
+			psX->fam28.Conf != psSave[i].Conf)) {
+			psX->Thi = psSave[i].Thi;
+			psX->Tlo = psSave[i].Tlo;
+			psX->fam28.Conf = psSave[i].Conf;			// Res0 (not written) on a DS18S20
+			psX->Res = psSave[i].Res;
+			if (OWP_BusSelect(&psX->sOW) == 1) {
+				ds18x20WriteSP(psX);
+				OWP_BusRelease(&psX->sOW);
+			}
+		}
+	}
+	free(psSave);
+}
+#endif
+
+// ####################################### Scenarios ###############################################
+
+static int OWP_BenchEnum(void) { return OWP_Scan(0, OWP_BenchCB); }
+
+static int OWP_BenchSense(void) {
+	#if (HAL_DS18X20 > 0)
+	epw_t sEWP = { .Tsns = 86400000 };				// half a day slack, every sensor is due
+	int iRV = ds18x20StartAllInOne(&sEWP);
+	return (iRV < erSUCCESS) ? iRV : Fam10_28Count;
+	#else
+	return 0;
+	#endif
+}
+
+static int OWP_BenchConfig(void) {
+	#if (HAL_DS18X20 > 0)
+	int iRV = ds18x20ConfigRange(0, Fam10_28Count, -10, 60, 12, 0);	// RAM only, no EE wear
+	return (iRV < erSUCCESS) ? iRV : Fam10_28Count;
+	#else
+	return 0;
+	#endif
+}
+
+static int OWP_BenchTag(void) {
+	u64_t ROM = OWP_BenchROM(OWFAMILY_01, 0x01);
+	u8_t LogBus = psaDS248X[0].Lo + OWP_BenchPhyBus();
+	ds248xSimAttach(0, OWP_BenchPhyBus(), ROM);
+	int iRV = OWP_ScanBus(LogBus, OWFAMILY_01, OWP_BenchCB);
+	ds248xSimDetach(0, OWP_BenchPhyBus(), ROM);
+	return iRV;
+}
+
+static int OWP_BenchDense(void) {
+	u8_t LogBus = psaDS248X[0].Lo + OWP_BenchPhyBus();
+	int Num = 0;
+	for (int i = 0; i < onewireBENCH_DENSE; ++i)
+		Num += (ds248xSimAttach(0, OWP_BenchPhyBus(), OWP_BenchROM(OWFAMILY_28, i)) == erSUCCESS);
+	int iRV = OWP_ScanBus(LogBus, 0, OWP_BenchCB);
+	for (int i = 0; i < onewireBENCH_DENSE; ++i)
+		ds248xSimDetach(0, OWP_BenchPhyBus(), OWP_BenchROM(OWFAMILY_28, i));
+	return (iRV < erSUCCESS) ? iRV : Num;
+}
+
+/* Recorded with owbench (host/README.md): simulator defaults, 1 DS2482-800 with ds248xSIM_DS18B20
+ * = 2 per channel (16 sensors), no DS18S20/DS1990, plus an empty RMT bus so that onewirePAR_SCAN
+ * fans "enum" out to 2 workers (the replay re-selects each channel). "dense" gets 6 of its 8
+ * devices, channel 7 already holds 2. */
+static const ow_bench_t sBase[] = {
+	{ "enum",	OWP_BenchEnum,		0,					16,	1072,	362608 },
+	{ "sense",	OWP_BenchSense,		benchSAVE_SCHED,	16,	288,	193180 },
+	{ "config",	OWP_BenchConfig,	benchSAVE_CONF,		16,	520,	274912 },
+	{ "tag",	OWP_BenchTag,		0,					1,	66,		22550 },
+	{ "dense",	OWP_BenchDense,		0,					6,	528,	180404 },
+};
+
+// ###################################### Public function ##########################################
+
+int	OWP_Bench(report_t * psR) {
+	int Fail = 0;
+	ds248xSimOwner(xTaskGetCurrentTaskHandle());
+	for (int i = 0; i < sizeof(sBase) / sizeof(sBase[0]); ++i) {
+		const ow_bench_t * psB = &sBase[i];
+		#if (HAL_DS18X20 > 0)
+		ow_bench_save_t * psSave = NULL;
+		if (psB->Save && Fam10_28Count) {
+			psSave = OWP_BenchSave();
+			if (psSave == NULL) {
+				SL_ERR("BENCH %s no memory to save the sensor state", psB->pcName);
+				++Fail;
+				continue;
+			}
+		}
+		#endif
+		ds248xsim_stat_t s0, s1;
+		OWP_BenchStats(&s0);
+		u64_t T0 = halTIMER_ReadRunTime();
+		int Items = psB->Run();
+		u64_t Twall = halTIMER_ReadRunTime() - T0;
+		OWP_BenchStats(&s1);
+		#if (HAL_DS18X20 > 0)
+		if (psSave)
+			OWP_BenchRestore(psSave, psB->Save);
+		#endif
+		u32_t Xfers = s1.Xfers - s0.Xfers;
+		u32_t Tbus = (s1.Tbus - s0.Tbus) / 1000ULL;
+		const char * pcRes = "NEW";
+		if (Items == psB->Items && psB->Xfers && psB->Tbus) {
+			bool Bad = ((u64_t) Xfers * 100 > (u64_t) psB->Xfers * (100 + onewireBENCH_TOL)) ||
+					   ((u64_t) Tbus * 100 > (u64_t) psB->Tbus * (100 + onewireBENCH_TOL));
+			pcRes = Bad ? "FAIL" : "PASS";
+			if (Bad) {
+				++Fail;
+				SL_ERR("BENCH %s regressed Xfers=%lu/%lu Tbus=%lu/%luuS", psB->pcName, Xfers, psB->Xfers, Tbus, psB->Tbus);
+			}
+		}
+		xReport(psR, "bench,%s,%d,%lu,%lu,%llu,%lu,%lu,%s\r\n", psB->pcName, Items, Xfers, Tbus,
+			Twall, psB->Xfers, psB->Tbus, pcRes);
+	}
+	ds248xSimOwner(NULL);
+	return Fail;
+}
+#endif
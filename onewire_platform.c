@@ -36,48 +36,142 @@ static const u8_t AC00Xlat[8] = { 3, 2, 1, 0, 4, 5, 6, 7 };
 owbi_t * psaOWBI = NULL;
 static u8_t	OWP_NumBus = 0, OWP_NumDev = 0;
 
+/* One block for every chip, bus & device table: allocated once, filled in config order (chips,
+ * buses, handles, then per family) so tables used together are adjacent, and never freed. */
+#if (onewireARENA_STATIC > 0)
+static u8_t Arena[onewireARENA_SIZE] __attribute__((aligned(8)));
+static u8_t * pArena = Arena;
+#else
+static u8_t * pArena = NULL;
+#endif
+static size_t ArenaUsed = 0, ArenaSpill = 0;
+static u8_t ArenaSpillCnt = 0;
+
+static owdh_t * psaOWDH = NULL;						// device handles, by bus then family once indexed
+static u8_t * pOWDH_Hash = NULL;					// ROM hash -> handle index + 1, 0 = empty
+static u8_t OWP_NumDH = 0;
+static u16_t OWP_HashMask = 0;
+
 /* In order to avoid multiple successive reads of the same iButton on the same OW channel
  * we filter reads based on the value of the iButton read and time expired since the last
  * successful read. If the same ID is read on the same channel within 'x' seconds, skip it */
 
+// ######################################### Memory arena ##########################################
+
+void * pvOWP_ArenaAlloc(size_t Size) {
+	Size = (Size + 7) & ~7;
+	#if (onewireARENA_STATIC == 0)
+	if (pArena == NULL) {
+		pArena = malloc(onewireARENA_SIZE);
+		IF_SL_ERR(pArena == NULL, "Arena alloc failed (%d)", onewireARENA_SIZE);
+	}
+	#endif
+	void * pvRV;
+	if (pArena && (ArenaUsed + Size) <= onewireARENA_SIZE) {
+		pvRV = pArena + ArenaUsed;
+		ArenaUsed += Size;
+	} else {
+		#if (onewireARENA_STATIC > 0)
+		SL_ERR("Arena full, %d + %d > %d", ArenaUsed, Size, onewireARENA_SIZE);
+		return NULL;
+		#else
+		pvRV = malloc(Size);							// keep running, report shows the shortfall
+		if (pvRV == NULL)
+			return NULL;
+		ArenaSpill += Size;
+		++ArenaSpillCnt;
+		#endif
+	}
+	memset(pvRV, 0, Size);
+	return pvRV;
+}
+
+static int OWP_ArenaReport(report_t * psR) {
+	return xReport(psR, "ARENA Size=%d Used=%d Free=%d Spill=%d/%d%s\r\n", onewireARENA_SIZE, ArenaUsed,
+		onewireARENA_SIZE - ArenaUsed, ArenaSpillCnt, ArenaSpill, onewireARENA_STATIC ? " (static)" : "");
+}
+
 // ################################# Application support functions #################################
 
+int	OWP_NumBusGet(void) { return OWP_NumBus; }
+
 owbi_t * psOWP_BusGetPointer(u8_t LogBus) {
 	IF_myASSERT(debugPARAM, halMemorySRAM((void*) psaOWBI) && (LogBus < OWP_NumBus));
 	return &psaOWBI[LogBus];
 }
 
 /**
- * @brief	Map LOGICAL (platform) bus to PHYSICAL (device) bus
- * @param	psOW - 1W device structure to be updated
- * @param	LogBus
- * @note	Physical device & bus info returned in the psOW structure
+ * @brief	Work out the PHYSICAL (device) bus of a LOGICAL (platform) bus, once per bus at config
+ * @note	Result stored in psaOWBI[LogBus], from there on OWP_BusL2P() is a table lookup
  */
-void OWP_BusL2P(owdi_t * psOW, u8_t LogBus) {
-	IF_myASSERT(debugPARAM, halMemorySRAM((void*) psOW) && (LogBus < OWP_NumBus));
+static void OWP_BusMap(u8_t LogBus) {
+	owbi_t * psOWBI = &psaOWBI[LogBus];
 	#if	(HAL_DS248X > 0)
 	extern u8_t ds248xCount;
 	for (int i = 0; i < ds248xCount; ++i) {
 		ds248x_t * psDS248X = &psaDS248X[i];
-		IF_PXL(debugTRACK && OPT_GET(dbgOWscan), "Log=%d Dev=%d Lo=%d Hi=%d", LogBus, i, psDS248X->Lo, psDS248X->Hi);
 		if (INRANGE(psDS248X->Lo, LogBus, psDS248X->Hi)) {
-			psOW->DevNum = i;
+			psOWBI->Type = owBUS_DS248x;
+			psOWBI->DevNum = i;
 #if (cmakePLTFRM == HW_AC01)
-			psOW->PhyBus = sSysFlags.ac00 ? AC00Xlat[LogBus - psDS248X->Lo] : LogBus - psDS248X->Lo;
+			psOWBI->PhyBus = sSysFlags.ac00 ? AC00Xlat[LogBus - psDS248X->Lo] : LogBus - psDS248X->Lo;
 #else
-			psOW->PhyBus = LogBus - psDS248X->Lo;
+			psOWBI->PhyBus = LogBus - psDS248X->Lo;
 #endif
-			IF_PXL(debugTRACK && OPT_GET(dbgOWscan), " -> P=%d\r\n", psOW->PhyBus);
-			return;
+			goto done;
+		}
+	}
+	#endif
+	#if (halRMT_1W > 0)
+	for (int i = 0; i < rmtCount; ++i) {				// 1 bus per GPIO
+		if (psaRMT[i].Lo == LogBus) {
+			psOWBI->Type = owBUS_RMT;
+			psOWBI->DevNum = i;
+			psOWBI->PhyBus = 0;
+			goto done;
+		}
+	}
+	#endif
+	#if (HAL_DS2480B > 0)
+	for (int i = 0; i < ds2480bCount; ++i) {			// 1 bus per UART
+		if (psaDS2480B[i].Lo == LogBus) {
+			psOWBI->Type = owBUS_DS2480B;
+			psOWBI->DevNum = i;
+			psOWBI->PhyBus = 0;
+			goto done;
 		}
-		IF_PXL(debugTRACK && OPT_GET(dbgOWscan), strNL);
 	}
 	#endif
 	SL_ERR("Invalid Logical Ch=%d", LogBus);
 	IF_myASSERT(debugRESULT, 0);
+	return;
+done:
+	IF_PX(debugTRACK && OPT_GET(dbgOWscan), "Log=%d -> T=%d D=%d P=%d\r\n", LogBus, psOWBI->Type, psOWBI->DevNum, psOWBI->PhyBus);
+}
+
+/**
+ * @brief	Map LOGICAL (platform) bus to PHYSICAL (device) bus
+ * @param	psOW - 1W device structure to be updated
+ * @param	LogBus
+ * @note	Physical device & bus info returned in the psOW structure
+ */
+void OWP_BusL2P(owdi_t * psOW, u8_t LogBus) {
+	IF_myASSERT(debugPARAM, halMemorySRAM((void*) psOW) && (LogBus < OWP_NumBus));
+	owbi_t * psOWBI = &psaOWBI[LogBus];
+	psOW->Type = psOWBI->Type;
+	psOW->DevNum = psOWBI->DevNum;
+	psOW->PhyBus = psOWBI->PhyBus;
 }
 
 int	OWP_BusP2L(owdi_t * psOW) {
+	#if (halRMT_1W > 0)
+	if (psOW->Type == owBUS_RMT)
+		return psaRMT[psOW->DevNum].Lo;
+	#endif
+	#if (HAL_DS2480B > 0)
+	if (psOW->Type == owBUS_DS2480B)
+		return psaDS2480B[psOW->DevNum].Lo;
+	#endif
 	IF_myASSERT(debugPARAM, halMemorySRAM((void*) psaDS248X) && halMemorySRAM((void*) psOW));
 	ds248x_t * psDS248X = &psaDS248X[psOW->DevNum];
 #if (cmakePLTFRM == HW_AC01)
@@ -87,15 +181,103 @@ int	OWP_BusP2L(owdi_t * psOW) {
 #endif
 }
 
+// ###################################### Device handle index ######################################
+
+static u16_t OWP_DevHash(u64_t ROM) {
+	u32_t H = ((u32_t) (ROM >> 8) ^ (u32_t) (ROM >> 32)) * 0x9E3779B1UL;	// serial bytes, CRC excluded
+	return (H >> 16) & OWP_HashMask;
+}
+
+void OWP_DevAdd(owdi_t * psOW, u8_t Slot) {
+	if (psaOWDH == NULL || OWP_NumDH >= OWP_NumDev) {
+		SL_ERR("Device table full (%d)", OWP_NumDev);
+		return;
+	}
+	psaOWDH[OWP_NumDH++] = (owdh_t) { .ROM = psOW->ROM.Value, .LogBus = OWP_BusP2L(psOW), .Slot = Slot };
+}
+
+/**
+ * @brief	Group the handles by bus then family, set each bus' DevLo and build the ROM hash
+ * @note	Once, after all families have enumerated. Insertion sort, the table is small and
+ *			already mostly ordered by bus.
+ */
+static void OWP_DevIndex(void) {
+	for (int i = 1; i < OWP_NumDH; ++i) {
+		owdh_t sDH = psaOWDH[i];
+		int j = i;
+		for (; j > 0 && (psaOWDH[j-1].LogBus > sDH.LogBus || (psaOWDH[j-1].LogBus == sDH.LogBus &&
+			(u8_t) psaOWDH[j-1].ROM > (u8_t) sDH.ROM)); --j)
+			psaOWDH[j] = psaOWDH[j-1];
+		psaOWDH[j] = sDH;
+	}
+	for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus)
+		psaOWBI[LogBus].DevLo = OWP_NumDH;				// sentinel = no devices
+	for (int i = OWP_NumDH - 1; i >= 0; --i)
+		psaOWBI[psaOWDH[i].LogBus].DevLo = i;
+	u16_t Size = 4;
+	while (Size < (OWP_NumDH * 2))						// <= 50% load, short probe sequences
+		Size <<= 1;
+	pOWDH_Hash = pvOWP_ArenaAlloc(Size);
+	if (pOWDH_Hash == NULL)
+		return;											// psOWP_DevFind() reports not found
+	OWP_HashMask = Size - 1;
+	for (int i = 0; i < OWP_NumDH; ++i) {
+		u16_t H = OWP_DevHash(psaOWDH[i].ROM);
+		while (pOWDH_Hash[H])
+			H = (H + 1) & OWP_HashMask;
+		pOWDH_Hash[H] = i + 1;
+	}
+}
+
+owdh_t * psOWP_BusDevs(u8_t LogBus, u8_t * pNum) {
+	IF_myASSERT(debugPARAM, LogBus < OWP_NumBus);
+	u8_t Lo = psaOWBI[LogBus].DevLo, Hi = Lo;
+	while (Hi < OWP_NumDH && psaOWDH[Hi].LogBus == LogBus)
+		++Hi;
+	*pNum = Hi - Lo;
+	return (Hi > Lo) ? &psaOWDH[Lo] : NULL;
+}
+
+owdh_t * psOWP_DevFind(u64_t ROM) {
+	if (pOWDH_Hash == NULL)
+		return NULL;
+	for (u16_t H = OWP_DevHash(ROM); pOWDH_Hash[H]; H = (H + 1) & OWP_HashMask) {
+		owdh_t * psDH = &psaOWDH[pOWDH_Hash[H] - 1];
+		if (psDH->ROM == ROM)
+			return psDH;
+	}
+	return NULL;
+}
+
 /**
  * @brief	Select the physical bus based on the 1W device info
  * @note	NOT an All-In-One function, bus MUST be released after completion
  * @param	psOW
  * @return	1 if selected, 0 if error
  */
-int	OWP_BusSelect(owdi_t * psOW) { return ds248xBusSelect(&psaDS248X[psOW->DevNum], psOW->PhyBus); }
+int	OWP_BusSelect(owdi_t * psOW) { return owOps[psOW->Type]->Select(psOW->DevNum, psOW->PhyBus, psOW->Pri); }
+
+int	OWP_BusYield(owdi_t * psOW) {
+	const ow_ops_t * psOps = owOps[psOW->Type];
+	return psOps->Yield ? psOps->Yield(psOW->DevNum, psOW->PhyBus, psOW->Pri) : 1;
+}
+
+void OWP_BusRelease(owdi_t * psOW) { owOps[psOW->Type]->Release(psOW->DevNum); }
 
-void OWP_BusRelease(owdi_t * psOW) { ds248xBusRelease(&psaDS248X[psOW->DevNum]); }
+/**
+ * @brief	Select the cheapest SAFE addressing method for a device
+ * @param	psOW
+ * @return	owADDR_SKIP if the device is the only one on its bus, else owADDR_MATCH
+ * @note	SKIP ROM saves the 8 ROM bytes MATCH ROM writes, 1447/7740uS -> 163/860uS per command.
+ *			A bus on which an iButton has ever been seen is dynamic: another device can appear at
+ *			any time, so it reverts (permanently) to MATCH ROM as soon as the first tag is read.
+ *			A bus whose full search was cut short (CRC, lost lock) may hold more than NumDev devices,
+ *			it also stays on MATCH ROM.
+ */
+int	OWP_BusAddrMode(owdi_t * psOW) {
+	owbi_t * psOW_CI = psOWP_BusGetPointer(OWP_BusP2L(psOW));
+	return (psOW_CI->NumDev == 1 && psOW_CI->Fam01 == 0 && psOW_CI->Part == 0) ? owADDR_SKIP : owADDR_MATCH;
+}
 
 // #################################### Handler functions ##########################################
 
@@ -143,6 +325,8 @@ int	OWP_PrintChan_CB(report_t * psR, owbi_t * psCI) {
 	iRV += xReport(psR, " OW#%d ", psR->sFM.uCount);
 	if (psCI->LastRead)
 		iRV += xReport(psR, "%R ", xTimeMakeTimeStamp(psCI->LastRead, 0));
+	if (psCI->NumDev)
+		iRV += xReport(psR, "Dev=%d ", psCI->NumDev);
 	if (psCI->ds18any)
 		iRV += xReport(psR, "DS18B=%d DS18S=%d", psCI->ds18b20, psCI->ds18s20);
 	if (fmTST(bNL))
@@ -157,6 +341,11 @@ int	OWP_PrintChan_CB(report_t * psR, owbi_t * psCI) {
  * @return
  */
 int	OWP_Count_CB(report_t * psR, owdi_t * psOW) {
+	owbi_t * psOW_CI = psOWP_BusGetPointer(OWP_BusP2L(psOW));
+	if (psOW->ROM.HexChars[owFAMILY] == OWFAMILY_01)
+		psOW_CI->Fam01 = 1;								// present at boot, but can leave/return
+	else
+		++psOW_CI->NumDev;								// static population, all families
 	switch (psOW->ROM.HexChars[owFAMILY]) {
 	#if (HAL_DS1990X > 0)							// DS1990A/R, 2401/11 devices
 	extern u8_t	Fam01Count;
@@ -190,75 +379,349 @@ int	OWP_ScanAlarms_CB(report_t * psR, owdi_t * psOW) {
 // ################################### Common Scanner functions ####################################
 
 /**
- * @brief	Scan ALL channels sequentially for [specified] family
- * @param	Family
- * @param	Handler
- * @param	psOW
- * @return	number of matching ROM's found (>= 0) or an error code (< 0)
+ * @brief	Search the (selected) bus for [specified] family, call handler for each ROM found
+ * @param	psR - report structure, uCount set to running count before calling handler
+ * @param	psOW - device structure, DevNum & PhyBus of the selected bus
+ * @param	puCount - running count of ROM's accepted by the handler
+ * @return	erSUCCESS or an error code (< 0) returned by the handler
  */
-int	OWP_Scan(u8_t Family, int (* Handler)(report_t *, owdi_t *)) {
+static int OWP_SearchBus(report_t * psR, owdi_t * psOW, u8_t LogBus, u8_t Family,
+						 int (* Handler)(report_t *, owdi_t *), u32_t * puCount) {
+	int iRV;
+	if (Family != 0) {
+		OWTargetSetup(psOW, Family);
+		iRV = OWSearch(psOW, 0);
+		if (iRV > 0 && (psOW->ROM.HexChars[owFAMILY] != Family)) {
+			// Strictly speaking should never get here, iRV must be 0 if same family not found
+			IF_PX(debugTRACK && OPT_GET(dbgOWscan), "Family 0x%02X wanted, 0x%02X found\r\n", Family, psOW->ROM.HexChars[owFAMILY]);
+			return erSUCCESS;
+		}
+	} else {
+		iRV = OWFirst(psOW, 0);
+	}
+	bool Done = (iRV == 0);								// nothing answered, nothing undercounted
+	while (iRV) {
+		psR->sFM.uCount = LogBus;
+		IF_EXEC_2(debugTRACK && OPT_GET(dbgOWscan), OWP_Print1W_CB, psR, psOW);
+		if (OWCheckCRC(psOW->ROM.HexChars, sizeof(ow_rom_t)) == 0) {
+			/* EMI-corrupted search result. WAS a live assert - field builds are DEBUG, so
+			 * one glitched search REBOOTED the unit AND discarded the leading-indicator
+			 * signal. Count per channel via the health pipeline and abandon this bus for
+			 * this pass: the search state is untrustworthy, continuing enumerates
+			 * phantom ROMs. */
+			#if (HAL_DS248X > 0) && (ds248xCHAN_ATTRIB > 0)
+			ds248xLogCRC(psOW->DevNum, psOW->PhyBus);
+			#endif
+			break;
+		}
+		psR->sFM.uCount = *puCount;
+		iRV = Handler(psR, psOW);
+		if (iRV < erSUCCESS)
+			return iRV;
+		if (iRV > 0)
+			++*puCount;
+		if (psOW->LDF) {							// no discrepancy left, search complete
+			Done = 1;
+			break;
+		}
+		if (OWP_BusYield(psOW) != 1)				// next search starts with a reset
+			break;
+		iRV = OWNext(psOW, 0);						// try to find next device (if any)
+	}
+	if (Family == 0 && Done == 0)
+		psaOWBI[LogBus].Part = 1;						// CRC, lost bus or failed pass, may undercount
+	return erSUCCESS;
+}
+
+/**
+ * @brief	Confirm a READ ROM result with a search down its path (AN187 verify). The wired-AND of
+ *			2+ devices can pass the CRC, the search then ends on another ROM or passes a discrepancy
+ *			it resolved to 0 (LDF not set).
+ * @return	1 if a single device holds the ROM
+ * @note	The ROM last accepted on the bus (a tag held in place) is taken without the search
+ */
+static bool OWP_ProbeConfirm(owdi_t * psOW, u8_t LogBus) {
+	u64_t ROM = psOW->ROM.Value;
+	if (ROM == psaOWBI[LogBus].LastROM.Value)
+		return 1;
+	psOW->LD = 64;
+	psOW->LDF = 0;
+	return OWSearch(psOW, 0) == 1 && psOW->ROM.Value == ROM && psOW->LDF == 1;
+}
+
+/**
+ * @brief	Check a (selected) probe bus for a single device using reset & READ ROM
+ * @return	erSUCCESS or an error code (< 0) returned by the handler
+ * @note	A reader probe holds 0 or 1 device: idle costs a single reset (1WRS), a tag held in place
+ *			a READ ROM (8 byte reads) instead of a 64 triplet search, a new tag is confirmed by
+ *			OWP_ProbeConfirm(). If the ROM read fails CRC or is not confirmed (2+ devices colliding
+ *			or corrupted) the bus is searched to resolve it.
+ */
+static int OWP_ProbeBus(report_t * psR, owdi_t * psOW, u8_t LogBus, u8_t Family,
+						int (* Handler)(report_t *, owdi_t *), u32_t * puCount) {
+	if (OWReset(psOW) == 0)								// no presence pulse, nothing to do
+		return erSUCCESS;
+	if (OWReadROM(psOW) == 0 || OWP_ProbeConfirm(psOW, LogBus) == 0)
+		return OWP_SearchBus(psR, psOW, LogBus, Family, Handler, puCount);
+	if (Family != 0 && psOW->ROM.HexChars[owFAMILY] != Family)
+		return erSUCCESS;
+	psR->sFM.uCount = LogBus;
+	IF_EXEC_2(debugTRACK && OPT_GET(dbgOWscan), OWP_Print1W_CB, psR, psOW);
+	psR->sFM.uCount = *puCount;
+	int iRV = Handler(psR, psOW);
+	if (iRV > 0)
+		++*puCount;
+	return iRV < erSUCCESS ? iRV : erSUCCESS;
+}
+
+static int OWP_ScanOne(report_t * psR, u8_t LogBus, u8_t Family,
+					   int (* Handler)(report_t *, owdi_t *), bool Probe, u32_t * puCount) {
+	owdi_t sOW;
+	memset(&sOW, 0, sizeof(owdi_t));
+	OWP_BusL2P(&sOW, LogBus);
+	sOW.Pri = Probe ? owPRI_INTERACTIVE : owPRI_BACKGROUND;		// probes are polled for people
+	if (OWP_BusSelect(&sOW) == 0)
+		return erSUCCESS;
+	int iRV = (Probe && psaOWBI[LogBus].NumDev == 0)
+			? OWP_ProbeBus(psR, &sOW, LogBus, Family, Handler, puCount)
+			: OWP_SearchBus(psR, &sOW, LogBus, Family, Handler, puCount);
+	OWP_BusRelease(&sOW);
+	return iRV;
+}
+
+/**
+ * @brief	Static families only live where something answered the boot enumeration (Family 0),
+ *			iButtons come and go so their probe buses are always visited
+ */
+static bool OWP_ScanSkip(u8_t LogBus, u8_t Family) {
+	return Family != 0 && Family != OWFAMILY_01 && psaOWBI[LogBus].NumDev == 0;
+}
+
+static int OWP_ScanAll(u8_t Family, int (* Handler)(report_t *, owdi_t *), bool Probe) {
 	IF_myASSERT(debugPARAM, halMemoryEXE((void*) Handler));
 	int	iRV = erSUCCESS;
 	u32_t uCount = 0;
-	owdi_t sOW;
 	report_t sRprt = {
 		.pcBuf = NULL,
 		.Size = repSIZE_SET(sNONE,sgrANSI,0,0,0),
 		.sFM.u32Val = makeMASK09x23(1,0,0,0,0,0,0,0,0,0),
 	};
 	for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
-		memset(&sOW, 0, sizeof(owdi_t));
-		OWP_BusL2P(&sOW, LogBus);
-		if (OWP_BusSelect(&sOW)) {
-			if (Family != 0) {
-				OWTargetSetup(&sOW, Family);
-				iRV = OWSearch(&sOW, 0);
-				if (iRV > 0 && (sOW.ROM.HexChars[owFAMILY] != Family)) {
-					// Strictly speaking should never get here, iRV must be 0 if same family not found
-					IF_PX(debugTRACK && OPT_GET(dbgOWscan), "Family 0x%02X wanted, 0x%02X found\r\n", Family, sOW.ROM.HexChars[owFAMILY]);
-					OWP_BusRelease(&sOW);
-					continue;
-				}
-			} else {
-				iRV = OWFirst(&sOW, 0);
-			}
-			while (iRV) {
-				sRprt.sFM.uCount = LogBus;
-				IF_EXEC_2(debugTRACK && OPT_GET(dbgOWscan), OWP_Print1W_CB, &sRprt, &sOW);
-				if (OWCheckCRC(sOW.ROM.HexChars, sizeof(ow_rom_t)) == 0) {
-					/* EMI-corrupted search result. WAS a live assert - field builds are DEBUG, so
-					 * one glitched search REBOOTED the unit AND discarded the leading-indicator
-					 * signal. Count per channel via the health pipeline and abandon this bus for
-					 * this pass: the search state is untrustworthy, continuing enumerates
-					 * phantom ROMs. */
-					#if (HAL_DS248X > 0) && (ds248xCHAN_ATTRIB > 0)
-					ds248xLogCRC(sOW.DevNum, sOW.PhyBus);
-					#endif
-					break;
-				}
+		if (OWP_ScanSkip(LogBus, Family))
+			continue;
+		iRV = OWP_ScanOne(&sRprt, LogBus, Family, Handler, Probe, &uCount);
+		if (iRV < erSUCCESS)
+			break;
+	}
+	if (iRV < erSUCCESS)
+		SL_ERR("Handler error=%d", iRV);
+	return iRV < erSUCCESS ? iRV : uCount;
+}
+
+// ####################################### Parallel scanning #######################################
+
+#if (onewirePAR_SCAN > 0)
+/* Each bridge chip (backend Type + DevNum) has its own 1-Wire engine and bus lock, so its buses are
+ * scanned by one worker while other chips' workers run. One parallel scan at a time (ParMux), the
+ * worker contexts are static. */
+typedef struct owp_par_t {
+	TaskHandle_t hTask;
+	int (* Handler)(report_t *, owdi_t *);			// MT safe handler, NULL = collect
+	int iRV;
+	u32_t uCount;
+	u8_t Num;
+	u8_t Full;
+	owdi_t sOW[onewirePAR_DEVS];
+} owp_par_t;
+
+static SemaphoreHandle_t ParMux = NULL;
+static EventGroupHandle_t ParEG = NULL;
+static owp_par_t sPar[onewirePAR_WORKERS];
+static u8_t ParKeyW[owBUS_NUM << 2];				// chip key -> worker, 0xFF = none
+static u8_t ParFamily;
+static TaskHandle_t ParOwner;						// task that started the scan
+
+static u8_t OWP_ParKey(u8_t LogBus) { return (psaOWBI[LogBus].Type << 2) | psaOWBI[LogBus].DevNum; }
+
+static int OWP_ParCollect_CB(report_t * psR, owdi_t * psOW) {
+	owp_par_t * psPar = sPar;
+	while (psPar->hTask != xTaskGetCurrentTaskHandle())
+		++psPar;
+	if (psPar->Num >= onewirePAR_DEVS) {
+		psPar->Full = 1;
+		return erNO_MEM;								// abandon, caller repeats sequentially
+	}
+	psPar->sOW[psPar->Num++] = *psOW;
+	return 1;
+}
+
+/**
+ * @brief	Scan the buses of the chip(s) assigned to a worker, in its own task or inline
+ */
+static void OWP_ParRun(owp_par_t * psPar) {
+	u8_t Wkr = psPar - sPar;
+	psPar->hTask = xTaskGetCurrentTaskHandle();
+	report_t sRprt = {
+		.pcBuf = NULL,
+		.Size = repSIZE_SET(sNONE,sgrANSI,0,0,0),
+		.sFM.u32Val = makeMASK09x23(1,0,0,0,0,0,0,0,0,0),
+	};
+	for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
+		if (ParKeyW[OWP_ParKey(LogBus)] != Wkr || OWP_ScanSkip(LogBus, ParFamily))
+			continue;
+		psPar->iRV = OWP_ScanOne(&sRprt, LogBus, ParFamily, psPar->Handler ? psPar->Handler : OWP_ParCollect_CB,
+			0, &psPar->uCount);
+		if (psPar->iRV < erSUCCESS)
+			break;
+	}
+	psPar->hTask = NULL;							// handle may be reused once the worker exits
+	xEventGroupSetBits(ParEG, 1UL << Wkr);
+}
+
+static void OWP_ParTask(void * pvPara) {
+	OWP_ParRun(pvPara);
+	vTaskDelete(NULL);
+}
+
+int	OWP_ScanPar(u8_t Family, int (* Handler)(report_t *, owdi_t *), u8_t Flags) {
+	IF_myASSERT(debugPARAM, halMemoryEXE((void*) Handler));
+	xRtosSemaphoreTake(&ParMux, portMAX_DELAY);
+	ParOwner = xTaskGetCurrentTaskHandle();
+	memset(ParKeyW, 0xFF, sizeof(ParKeyW));
+	int NumW = 0;
+	for (int LogBus = 0; LogBus < OWP_NumBus && NumW <= onewirePAR_WORKERS; ++LogBus) {
+		u8_t Key = OWP_ParKey(LogBus);
+		if (ParKeyW[Key] == 0xFF)
+			ParKeyW[Key] = NumW++;
+	}
+	if (NumW < 2 || NumW > onewirePAR_WORKERS) {	// nothing to gain, or more chips than workers
+		xRtosSemaphoreGive(&ParMux);
+		return OWP_ScanAll(Family, Handler, 0);
+	}
+	if (ParEG == NULL)
+		ParEG = xEventGroupCreate();
+	xEventGroupClearBits(ParEG, (1UL << NumW) - 1);
+	ParFamily = Family;
+	for (int w = 0; w < NumW; ++w) {
+		owp_par_t * psPar = &sPar[w];
+		psPar->hTask = NULL;
+		psPar->Handler = (Flags & owpSCAN_MTSAFE) ? Handler : NULL;
+		psPar->iRV = erSUCCESS;
+		psPar->uCount = psPar->Num = psPar->Full = 0;
+		if (xTaskCreate(OWP_ParTask, "owScan", onewirePAR_STACK, psPar, uxTaskPriorityGet(NULL), NULL) != pdPASS) {
+			OWP_ParRun(psPar);							// no memory for a worker, scan its chip here:
+			psPar->hTask = NULL;						// every ROM is still handled exactly once
+		}
+	}
+	xEventGroupWaitBits(ParEG, (1UL << NumW) - 1, pdTRUE, pdTRUE, portMAX_DELAY);
+
+	int iRV = erSUCCESS;
+	u32_t uCount = 0;
+	for (int w = 0; w < NumW; ++w) {
+		if (sPar[w].Full) {								// collecting only, no handler called yet
+			xRtosSemaphoreGive(&ParMux);
+			SL_WARN("Worker %d overflow, scanning sequentially", w);
+			return OWP_ScanAll(Family, Handler, 0);
+		}
+		if (sPar[w].iRV < erSUCCESS)
+			iRV = sPar[w].iRV;
+		uCount += sPar[w].uCount;
+	}
+	if ((Flags & owpSCAN_MTSAFE) == 0 && iRV == erSUCCESS) {
+		/* Replay collected ROMs in logical bus order, bus selected as in OWP_SearchBus(), so the
+		 * handler sees exactly what a sequential scan would have shown it */
+		u8_t Next[onewirePAR_WORKERS] = { 0 };
+		report_t sRprt = {
+			.pcBuf = NULL,
+			.Size = repSIZE_SET(sNONE,sgrANSI,0,0,0),
+			.sFM.u32Val = makeMASK09x23(1,0,0,0,0,0,0,0,0,0),
+		};
+		uCount = 0;
+		for (int LogBus = 0; LogBus < OWP_NumBus && iRV >= erSUCCESS; ++LogBus) {
+			u8_t w = ParKeyW[OWP_ParKey(LogBus)];
+			owp_par_t * psPar = &sPar[w];
+			if (Next[w] >= psPar->Num || OWP_BusP2L(&psPar->sOW[Next[w]]) != LogBus)
+				continue;
+			owdi_t * psOW0 = &psPar->sOW[Next[w]];
+			bool Sel = OWP_BusSelect(psOW0), Held = Sel;	// failed yield still holds the lock
+			for (; Next[w] < psPar->Num && OWP_BusP2L(&psPar->sOW[Next[w]]) == LogBus; ++Next[w]) {
+				if (Sel == 0)
+					continue;								// bus lost since the search, skip its ROMs
+				owdi_t * psOW = &psPar->sOW[Next[w]];
 				sRprt.sFM.uCount = uCount;
-				iRV = Handler(&sRprt, &sOW);
+				iRV = Handler(&sRprt, psOW);
 				if (iRV < erSUCCESS)
 					break;
 				if (iRV > 0)
 					++uCount;
-				iRV = OWNext(&sOW, 0);						// try to find next device (if any)
+				Sel = (OWP_BusYield(psOW) == 1);
 			}
-			OWP_BusRelease(&sOW);
-			if (iRV < erSUCCESS)
-				break;
+			if (Held)
+				OWP_BusRelease(psOW0);
 		}
 	}
+	xRtosSemaphoreGive(&ParMux);
 	if (iRV < erSUCCESS)
 		SL_ERR("Handler error=%d", iRV);
 	return iRV < erSUCCESS ? iRV : uCount;
 }
 
+TaskHandle_t OWP_ScanOwner(void) {
+	TaskHandle_t hTask = xTaskGetCurrentTaskHandle();
+	for (int w = 0; w < onewirePAR_WORKERS; ++w) {
+		if (sPar[w].hTask == hTask)
+			return ParOwner;
+	}
+	return hTask;
+}
+#endif
+
+/**
+ * @brief	Scan ALL channels for [specified] family, sequentially unless onewirePAR_SCAN
+ * @param	Family
+ * @param	Handler
+ * @return	number of matching ROM's found (>= 0) or an error code (< 0)
+ */
+int	OWP_Scan(u8_t Family, int (* Handler)(report_t *, owdi_t *)) {
+	#if (onewirePAR_SCAN > 0)
+	return OWP_ScanPar(Family, Handler, 0);
+	#else
+	return OWP_ScanAll(Family, Handler, 0);
+	#endif
+}
+
+/**
+ * @brief	Scan ALL channels for [specified] family, channels without devices at boot (probes)
+ *			using the reset & READ ROM fast path, others with a full search as per OWP_Scan()
+ * @return	number of matching ROM's found (>= 0) or an error code (< 0)
+ */
+int	OWP_ScanProbe(u8_t Family, int (* Handler)(report_t *, owdi_t *)) {
+	return OWP_ScanAll(Family, Handler, 1);
+}
+
+/**
+ * @brief	Scan a single LOGICAL channel for [specified] family, probe fast path as per OWP_ScanProbe()
+ * @return	number of matching ROM's found (>= 0) or an error code (< 0)
+ */
+int	OWP_ScanBus(u8_t LogBus, u8_t Family, int (* Handler)(report_t *, owdi_t *)) {
+	IF_myASSERT(debugPARAM, halMemoryEXE((void*) Handler) && (LogBus < OWP_NumBus));
+	u32_t uCount = 0;
+	report_t sRprt = {
+		.pcBuf = NULL,
+		.Size = repSIZE_SET(sNONE,sgrANSI,0,0,0),
+		.sFM.u32Val = makeMASK09x23(1,0,0,0,0,0,0,0,0,0),
+	};
+	int iRV = OWP_ScanOne(&sRprt, LogBus, Family, Handler, 1, &uCount);
+	IF_SL_ERR(iRV < erSUCCESS, "Handler error=%d", iRV);
+	return iRV < erSUCCESS ? iRV : uCount;
+}
+
 int	OWP_Scan2(u8_t Family, int (* Handler)(report_t *, void *, owdi_t *), void * pVoid) {
 	IF_myASSERT(debugPARAM, halMemoryANY(Handler));
 	int	iRV = erSUCCESS;
 	u32_t uCount = 0;
 	owdi_t sOW;
+	memset(&sOW, 0, sizeof(owdi_t));					// Pri (owPRI_BACKGROUND) & search state
 	report_t sRprt = { .pcBuf = NULL, .Size = 0, .sFM.u32Val = makeMASK09x23(1,0,0,0,0,0,0,0,0,0) };
 	for (u8_t LogBus = 0; LogBus < OWP_NumBus; ++LogBus) {
 		OWP_BusL2P(&sOW, LogBus);
@@ -323,15 +786,30 @@ int	OWP_Config(void) {
 		OWP_NumBus	+= (psDS248X->NumChan ? 8 : 1);
 	}
 	#endif
+	#if (halRMT_1W > 0)
+	rmtOWConfig();
+	for (int i = 0; i < rmtCount; ++i)
+		psaRMT[i].Lo = OWP_NumBus++;
+	#endif
+	#if (HAL_DS2480B > 0)
+	ds2480bConfig();
+	for (int i = 0; i < ds2480bCount; ++i)
+		psaDS2480B[i].Lo = OWP_NumBus++;
+	#endif
 
 	// When all technologies & devices individually enumerated
 	if (OWP_NumBus) {
-		psaOWBI = malloc(OWP_NumBus * sizeof(owbi_t));	// initialize the logical channel structures
-		memset(psaOWBI, 0, OWP_NumBus * sizeof(owbi_t));
+		psaOWBI = pvOWP_ArenaAlloc(OWP_NumBus * sizeof(owbi_t));	// initialize the logical channel structures
+		if (psaOWBI == NULL)
+			return erNO_MEM;
+		for (int LogBus = 0; LogBus < OWP_NumBus; ++LogBus)
+			OWP_BusMap(LogBus);
 		// enumerate any/all physical devices (possibly) (permanently) attached to individual channel(s)
 		int	iRV = OWP_Scan(0, OWP_Count_CB);
 		if (iRV > 0)
 			OWP_NumDev += iRV;
+		if (OWP_NumDev)
+			psaOWDH = pvOWP_ArenaAlloc(OWP_NumDev * sizeof(owdh_t));	// NULL: OWP_DevAdd() reports
 
 		#if (HAL_DS18X20 > 0)
 		if (Fam10Count || Fam28Count)
@@ -341,18 +819,69 @@ int	OWP_Config(void) {
 		#if	(HAL_DS1990X > 0)
 		ds1990xConfig();								// cannot enumerate, simple config
 		#endif
+		OWP_DevIndex();
 	}
 	return OWP_NumDev;
 }
 
+void * pvOWP_SnapSection(owsnap_wr_t * psW, u8_t Type, u8_t RecSize, u16_t Num) {
+	size_t Size = sizeof(owsnap_sec_t) + (size_t) RecSize * Num;
+	if (psW->Full || (psW->pCur + Size) > psW->pEnd) {
+		psW->Full = 1;
+		return NULL;
+	}
+	*(owsnap_sec_t *) psW->pCur = (owsnap_sec_t) { .Type = Type, .RecSize = RecSize, .Num = Num };
+	void * pvRV = psW->pCur + sizeof(owsnap_sec_t);
+	psW->pCur += Size;
+	++psW->NumSec;
+	return pvRV;
+}
+
+int	OWP_Snapshot(u8_t * pBuf, size_t Size) {
+	IF_myASSERT(debugPARAM, halMemorySRAM(pBuf));
+	static u16_t Seq = 0;
+	if (Size < sizeof(owsnap_hdr_t))
+		return erNO_MEM;
+	owsnap_wr_t sW = { .pBuf = pBuf, .pCur = pBuf + sizeof(owsnap_hdr_t), .pEnd = pBuf + Size };
+	owsnap_bus_t * psBus = pvOWP_SnapSection(&sW, owsnapSEC_BUS, sizeof(owsnap_bus_t), OWP_NumBus);
+	for (int i = 0; psBus && i < OWP_NumBus; ++i) {
+		owbi_t * psOWBI = &psaOWBI[i];
+		psBus[i] = (owsnap_bus_t) { .Type = psOWBI->Type, .DevNum = psOWBI->DevNum, .PhyBus = psOWBI->PhyBus,
+			.Fam01 = psOWBI->Fam01, .NumDev = psOWBI->NumDev };
+	}
+	owsnap_rom_t * psROM = pvOWP_SnapSection(&sW, owsnapSEC_ROM, sizeof(owsnap_rom_t), OWP_NumDH);
+	for (int i = 0; psROM && i < OWP_NumDH; ++i)
+		psROM[i] = (owsnap_rom_t) { .ROM = psaOWDH[i].ROM, .LogBus = psaOWDH[i].LogBus, .Slot = psaOWDH[i].Slot };
+	#if (HAL_DS18X20 > 0)
+	ds18x20Snapshot(&sW);
+	#endif
+	#if (HAL_DS248X > 0)
+	ds248xSnapshot(&sW);
+	#endif
+	if (sW.Full)
+		return erNO_MEM;
+	*(owsnap_hdr_t *) pBuf = (owsnap_hdr_t) { .Magic = owsnapMAGIC, .Version = owsnapVERSION,
+		.NumSec = sW.NumSec, .Len = sW.pCur - pBuf, .Seq = Seq++, .Uptime = xTaskGetTickCount() / configTICK_RATE_HZ };
+	return sW.pCur - pBuf;
+}
+
 int OWP_Report(report_t * psR) {
-	int iRV = 0;
+	int iRV = OWP_ArenaReport(psR);
 	#if (HAL_DS248X > 0)
 	iRV += ds248xReportAll(psR);
 	#endif
+	#if (halRMT_1W > 0)
+	iRV += rmtOWReportAll(psR);
+	#endif
+	#if (HAL_DS2480B > 0)
+	iRV += ds2480bReportAll(psR);
+	#endif
 	#if (HAL_DS18X20 > 0)
 	iRV += ds18x20ReportAll(psR);
 	#endif
+	#if (HAL_DS1990X > 0)
+	iRV += ds1990xReportAll(psR);
+	#endif
 	return iRV;
 }
 
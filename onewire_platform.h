@@ -9,6 +9,8 @@
 #include "priv/ds1990x.h"
 #include "priv/ds18x20.h"
 #include "priv/esp_rmt.h"
+#include "priv/ds2480b.h"
+#include "onewire_snap.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,12 +18,55 @@ extern "C" {
 
 // ############################################# Macros ############################################
 
+#ifndef onewireARENA_SIZE
+	#define	onewireARENA_SIZE	4096				// bytes, all chip, bus & device tables
+#endif
+
+#ifndef onewireARENA_STATIC
+	#define	onewireARENA_STATIC	0					// 1 = arena is a static array, no heap use at all
+#endif
+
+#ifndef onewirePAR_SCAN
+	#define	onewirePAR_SCAN		0					// 1 = OWP_Scan() fans out to a worker per bridge chip
+#endif
+
+#ifndef onewirePAR_WORKERS
+	#define	onewirePAR_WORKERS	4					// max concurrent scan workers
+#endif
+
+#ifndef onewirePAR_DEVS
+	#define	onewirePAR_DEVS		48					// ROMs buffered per worker, beyond that scan sequentially
+#endif
+
+#ifndef onewirePAR_STACK
+	#define	onewirePAR_STACK	3072				// worker task stack, search + MT safe handler
+#endif
+
+#ifndef onewireSOCK
+	#define	onewireSOCK			0					// host (linux) builds: local socket read service
+#endif
+
+#ifndef onewireSOCK_PATH
+	#define	onewireSOCK_PATH	"/tmp/onewire.sock"
+#endif
+
+#ifndef onewireBENCH
+	#define	onewireBENCH		0					// benchmark scenarios, requires ds248xSIMULATE
+#endif
+
 // ######################################## Enumerations ###########################################
 
+enum {												// OWP_ScanPar() Flags
+	owpSCAN_MTSAFE		= (1 << 0),					// handler may run concurrently in the workers
+};
+
 // ######################################### Structures ############################################
 
 /* Bus related info, ie last device read (ROM & timestamp)
  * Used to avoid re-reading a device (primarily DS1990X type) too regularly.
+ * NumDev/Fam01/Part describe the bus population, used to select SKIP vs MATCH ROM addressing.
+ * PhyBus/DevNum/Type is the logical -> physical map, built once in OWP_Config().
+ * DevLo is the first of NumDev handles for this bus in the device table, see OWP_BusDevs().
  */
 typedef struct __attribute__((packed)) owbi_t {
 	seconds_t	LastRead;			// size=4
@@ -30,17 +75,68 @@ typedef struct __attribute__((packed)) owbi_t {
 		struct { u8_t ds18b20:4, ds18s20:4; };
 		u8_t ds18any;
 	};
+	u8_t NumDev;					// devices (all families, iButtons excluded) enumerated at boot
+	u8_t Fam01;						// 1 = iButton seen on this bus, population is dynamic (sticky)
+	struct __attribute__((packed)) {
+		u8_t PhyBus:3;
+		u8_t DevNum:2;
+		u8_t Type:2;				// owBUS_? backend
+		u8_t Part:1;				// 1 = a full search did not complete, NumDev may undercount (sticky)
+	};
+	u8_t DevLo;						// index of first device handle
 } owbi_t;
-DUMB_STATIC_ASSERT(sizeof(owbi_t) == 13);
+DUMB_STATIC_ASSERT(sizeof(owbi_t) == 17);
+
+typedef struct owsnap_wr_t {		// OWP_Snapshot() writer state
+	u8_t * pBuf;
+	u8_t * pCur;
+	u8_t * pEnd;
+	u8_t NumSec;
+	u8_t Full;						// a section did not fit
+} owsnap_wr_t;
+
+typedef struct owdh_t {				// enumerated (static population) device handle
+	u64_t ROM;
+	u8_t LogBus;
+	u8_t Slot;						// index into the family driver table, eg psaDS18X20
+} owdh_t;
 
 // #################################### Public Data structures #####################################
 
 // ###################################### Public functions #########################################
 
+/**
+ * @brief	Allocate zeroed, 8 byte aligned, from the 1-Wire arena. Config time only, never freed.
+ * @return	pointer, or NULL if neither the arena nor (dynamic mode) the heap can satisfy it
+ * @note	Requests that do not fit spill to the heap and are counted, see OWP_Report()
+ */
+void * pvOWP_ArenaAlloc(size_t Size);
+
+int	OWP_NumBusGet(void);
 owbi_t * psOWP_BusGetPointer(u8_t);
 void OWP_BusL2P(owdi_t *, u8_t);
 int	OWP_BusP2L(owdi_t *);
+int	OWP_BusAddrMode(owdi_t *);
+
+/**
+ * @brief	Record an enumerated device, called from the family enumeration callbacks
+ * @param	Slot - index of the device in the family driver table
+ */
+void OWP_DevAdd(owdi_t * psOW, u8_t Slot);
+
+/**
+ * @brief	Device handles on a bus, grouped by family (ascending)
+ * @return	pointer to the first of *pNum handles, NULL if none
+ */
+owdh_t * psOWP_BusDevs(u8_t LogBus, u8_t * pNum);
+
+/**
+ * @brief	O(1) lookup of an enumerated device by ROM
+ * @return	pointer to the handle, NULL if not found
+ */
+owdh_t * psOWP_DevFind(u64_t ROM);
 int	OWP_BusSelect(owdi_t *);
+int	OWP_BusYield(owdi_t *);
 void OWP_BusRelease(owdi_t *);
 
 // Common callback handlers
@@ -50,12 +146,62 @@ int	OWP_PrintChan_CB(struct report_t * psR, owbi_t * psCI);
 int	OWP_Count_CB(struct report_t * psR, owdi_t *);
 
 int	OWP_Scan(u8_t, int (*)(struct report_t *, owdi_t *));
+int	OWP_ScanProbe(u8_t, int (*)(struct report_t *, owdi_t *));
+int	OWP_ScanBus(u8_t, u8_t, int (*)(struct report_t *, owdi_t *));
+
+#if (onewirePAR_SCAN > 0)
+/**
+ * @brief	Scan ALL channels for [specified] family, one worker task per bridge chip
+ * @param	Flags - owpSCAN_MTSAFE: call Handler from the workers as ROMs are found, in any order,
+ *			psR->sFM.uCount is then a per worker count. Otherwise ROMs are collected and Handler is
+ *			called in this task, in logical bus order with the bus selected, as OWP_Scan() does.
+ * @return	number of matching ROM's found (>= 0) or an error code (< 0)
+ * @note	A worker that cannot be created is run in the calling task. An error is only returned
+ *			for a Handler error, with MTSAFE other workers may have handled ROMs by then, exactly
+ *			as earlier buses have in a sequential scan.
+ */
+int	OWP_ScanPar(u8_t Family, int (* Handler)(struct report_t *, owdi_t *), u8_t Flags);
+
+/**
+ * @brief	Task the current 1-Wire traffic is done for: the task that started the parallel scan
+ *			when called from one of its workers, else the current task
+ */
+TaskHandle_t OWP_ScanOwner(void);
+#endif
 int	OWP_Scan2(u8_t, int (*)(struct report_t *, void *, owdi_t *), void *);
 int	OWP_ScanAlarmsFamily(u8_t Family);
 
 int	OWP_Config(void);
 int OWP_Report(struct report_t * psR);
 
+/**
+ * @brief	Write a binary snapshot (onewire_snap.h) of topology, ROMs, readings & health to pBuf
+ * @return	bytes written, or erNO_MEM if Size is too small
+ */
+int	OWP_Snapshot(u8_t * pBuf, size_t Size);
+
+/**
+ * @brief	Append a section header for Num records of RecSize bytes
+ * @return	pointer to where the records go, NULL (and psW->Full set) if they do not fit
+ */
+void * pvOWP_SnapSection(owsnap_wr_t * psW, u8_t Type, u8_t RecSize, u16_t Num);
+
+#if defined(__linux__) && (onewireSOCK > 0)
+/**
+ * @brief	Serve ds18x20ReadCached() on the local socket onewireSOCK_PATH, see onewire_sock.c
+ * @return	erSUCCESS or erFAILURE if the socket could not be set up
+ */
+int	OWP_SockStart(void);
+#endif
+
+#if (onewireBENCH > 0)
+/**
+ * @brief	Run all benchmark scenarios, one CSV line each, compared to stored baselines
+ * @return	number of scenarios that regressed beyond onewireBENCH_TOL
+ */
+int	OWP_Bench(struct report_t * psR);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+// onewire_snap.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+
+/* Binary snapshot of the 1-Wire inventory, readings and health, see OWP_Snapshot().
+ * Shared by the device (writer) and monitoring hosts (reader): only <stdint.h>, all multi-byte
+ * fields little endian, all structures packed. A snapshot is a header followed by sections, each
+ * a section header and Num fixed size records. Readers skip unknown section types and ignore
+ * trailing bytes of records larger than they know (RecSize), so sections and fields can be
+ * appended without bumping owsnapVERSION - only changing the meaning of an existing field does.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ############################################# Macros ############################################
+
+#define	owsnapMAGIC					0x534F				// "OS"
+#define	owsnapVERSION				1
+
+// ######################################## Enumerations ###########################################
+
+enum {													// owsnap_sec_t.Type
+	owsnapSEC_BUS = 1,									// owsnap_bus_t, one per logical bus
+	owsnapSEC_ROM,										// owsnap_rom_t, one per enumerated device
+	owsnapSEC_TEMP,										// owsnap_temp_t, one per DS18x20
+	owsnapSEC_CHIP,										// owsnap_chip_t, one per DS248x
+	owsnapSEC_ACT,										// owsnap_act_t, 8 per DS248x (ds248xSTAT_DEBUG)
+};
+
+// ######################################### Structures ############################################
+
+typedef struct __attribute__((packed)) owsnap_hdr_t {
+	uint16_t Magic;
+	uint8_t Version;
+	uint8_t NumSec;
+	uint16_t Len;						// total bytes including this header
+	uint16_t Seq;						// snapshot number since boot, detects missed polls
+	uint32_t Uptime;					// seconds
+} owsnap_hdr_t;
+
+typedef struct __attribute__((packed)) owsnap_sec_t {
+	uint8_t Type;						// owsnapSEC_?
+	uint8_t RecSize;					// bytes per record
+	uint16_t Num;						// records following
+} owsnap_sec_t;
+
+typedef struct __attribute__((packed)) owsnap_bus_t {
+	uint8_t Type : 2;					// owBUS_? backend
+	uint8_t DevNum : 2;					// chip, per backend
+	uint8_t PhyBus : 3;					// channel on the chip
+	uint8_t Fam01 : 1;					// iButton seen, population is dynamic
+	uint8_t NumDev;						// static devices enumerated at boot
+} owsnap_bus_t;
+
+typedef struct __attribute__((packed)) owsnap_rom_t {
+	uint64_t ROM;						// family in the low byte
+	uint8_t LogBus;
+	uint8_t Slot;						// index into the family table, eg owsnap_temp_t
+} owsnap_rom_t;
+
+typedef struct __attribute__((packed)) owsnap_temp_t {
+	int16_t Raw;						// last sample, 1/16 C (ROM family 28) or 1/2 C (family 10)
+	int16_t Tpub;						// last published, same units
+	uint16_t Age;						// seconds since published, saturates
+	uint8_t LogBus;
+	uint8_t Res : 2;					// 0=9 -> 3=12 bit
+	uint8_t Pub : 1;					// Tpub/Age valid
+	uint8_t Spare : 5;
+} owsnap_temp_t;
+
+typedef struct __attribute__((packed)) owsnap_chip_t {
+	uint8_t Type;						// i2cDEV_? device type
+	uint8_t State;						// 0=OK 1=ERRORS 2=WEDGED
+	uint8_t WedgeCnt;
+	uint8_t Lo;							// first logical bus
+	uint16_t XErr;						// counters of the current health window
+	uint16_t Skip;
+	uint16_t Bkof;
+	uint16_t Err[8];					// per channel
+} owsnap_chip_t;
+
+typedef struct __attribute__((packed)) owsnap_act_t {
+	uint32_t Rst, PPD, Trip, Tag;		// lifetime per channel activity
+} owsnap_act_t;
+
+// ####################################### Reader support ##########################################
+
+/**
+ * @brief	Validate a snapshot and locate a section
+ * @param	pNum - set to the number of records, pRecSize - set to the record size
+ * @return	pointer to the first record, NULL if invalid or section not present
+ */
+static inline const uint8_t * owsnapFind(const uint8_t * pBuf, size_t Len, uint8_t Type, uint16_t * pNum, uint8_t * pRecSize) {
+	const owsnap_hdr_t * psHdr = (const owsnap_hdr_t *) pBuf;
+	if (Len < sizeof(owsnap_hdr_t) || psHdr->Magic != owsnapMAGIC || psHdr->Version != owsnapVERSION || psHdr->Len > Len)
+		return NULL;
+	size_t Ofs = sizeof(owsnap_hdr_t);
+	for (int i = 0; i < psHdr->NumSec && (Ofs + sizeof(owsnap_sec_t)) <= psHdr->Len; ++i) {
+		const owsnap_sec_t * psSec = (const owsnap_sec_t *) (pBuf + Ofs);
+		Ofs += sizeof(owsnap_sec_t);
+		size_t Size = (size_t) psSec->RecSize * psSec->Num;
+		if ((Ofs + Size) > psHdr->Len)
+			return NULL;
+		if (psSec->Type == Type) {
+			*pNum = psSec->Num;
+			*pRecSize = psSec->RecSize;
+			return pBuf + Ofs;
+		}
+		Ofs += Size;
+	}
+	return NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
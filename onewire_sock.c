@@ -0,0 +1,135 @@
+/*
+ * onewire_sock.c - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ *
+ * Local (AF_UNIX) socket front end to the DS18x20 cached read service, host (linux target)
+ * builds only. One task per connection so concurrent clients coalesce in ds18x20ReadCached(), all
+ * FreeRTOS tasks since every request ends up in the driver & RTOS APIs.
+ * Line protocol, one request per line:
+ *	T <idx> <maxage_mS>		->	<idx> <raw> <milli C>		raw as ds18x20ReadCached(), see ds18x20RAW_DIV()
+ *	S						->	<hit> <miss> <coal> <fail>
+ *	U						->	<idx> <milli C> pairs of the sensors published since the last U,
+ *								as many as fit a line, the rest on the next U (ds18x20Updated())
+ * Errors are answered with "ERR <code>".
+ */
+
+#include "hal_platform.h"
+
+#if defined(__linux__) && (HAL_ONEWIRE > 0) && (HAL_DS18X20 > 0) && (onewireSOCK > 0)
+#include "onewire_platform.h"
+#include "syslog.h"
+#include "errors_events.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// ###################################### General macros ###########################################
+
+#define	debugFLAG					0xF000
+
+#define	debugTIMING					(debugFLAG_GLOBAL & debugFLAG & 0x1000)
+#define	debugTRACK					(debugFLAG_GLOBAL & debugFLAG & 0x2000)
+#define	debugPARAM					(debugFLAG_GLOBAL & debugFLAG & 0x4000)
+#define	debugRESULT					(debugFLAG_GLOBAL & debugFLAG & 0x8000)
+
+// ######################################## Build macros ###########################################
+
+#define	onewireSOCK_STACK			3072			// per task: request line, answer & ReadCached()
+#define	onewireSOCK_PRIO			2
+
+// ###################################### Local functions ##########################################
+
+extern u8_t Fam10_28Count;
+
+static void OWP_SockAnswer(int Fd, char * pcReq) {
+	char caBuf[128];
+	int Idx, Len;
+	unsigned MaxAge;
+	if (sscanf(pcReq, "T %d %u", &Idx, &MaxAge) == 2) {
+		i16_t Raw;
+		int iRV = ds18x20ReadCached(Idx, MaxAge, &Raw);
+		Len = (iRV == erSUCCESS)
+			? snprintf(caBuf, sizeof(caBuf), "%d %d %d\n", Idx, Raw, (Raw * 1000) / ds18x20RAW_DIV(&psaDS18X20[Idx]))
+			: snprintf(caBuf, sizeof(caBuf), "ERR %d\n", iRV);
+	} else if (pcReq[0] == 'S') {
+		ds18x20cache_t sStats;
+		ds18x20CacheStats(&sStats);
+		Len = snprintf(caBuf, sizeof(caBuf), "%lu %lu %lu %lu\n", (unsigned long) sStats.Hit,
+			(unsigned long) sStats.Miss, (unsigned long) sStats.Coal, (unsigned long) sStats.Fail);
+	} else if (pcReq[0] == 'U') {
+		Len = 0;										// flags are only taken while a pair fits
+		for (int i = 0; i < Fam10_28Count && Len < (sizeof(caBuf) - 16); ++i) {
+			ds18x20_t * psDS18X20 = &psaDS18X20[i];
+			if (ds18x20Updated(i) == 1)
+				Len += snprintf(caBuf + Len, sizeof(caBuf) - Len, Len ? " %d %d" : "%d %d", i,
+					(psDS18X20->Tpub * 1000) / ds18x20RAW_DIV(psDS18X20));
+		}
+		caBuf[Len++] = '\n';
+	} else {
+		Len = snprintf(caBuf, sizeof(caBuf), "ERR %d\n", erINV_VALUE);
+	}
+	if (write(Fd, caBuf, Len) != Len)
+		SL_DBG("short write fd=%d", Fd);
+}
+
+static void OWP_SockClient(void * pvPara) {
+	int Fd = (int) (intptr_t) pvPara;
+	char caReq[64];
+	int Have = 0, Len;
+	while ((Len = read(Fd, caReq + Have, sizeof(caReq) - 1 - Have)) > 0) {
+		Have += Len;
+		caReq[Have] = 0;
+		char * pcEOL;
+		while ((pcEOL = strchr(caReq, '\n')) != NULL) {
+			*pcEOL = 0;
+			OWP_SockAnswer(Fd, caReq);
+			Have -= (pcEOL + 1) - caReq;
+			memmove(caReq, pcEOL + 1, Have + 1);
+		}
+		if (Have == sizeof(caReq) - 1)					// no newline in a full buffer, drop it
+			Have = 0;
+	}
+	close(Fd);
+	vTaskDelete(NULL);
+}
+
+static void OWP_SockServer(void * pvPara) {
+	int Srv = (int) (intptr_t) pvPara;
+	while (1) {
+		int Fd = accept(Srv, NULL, NULL);
+		if (Fd < 0)
+			continue;
+		if (xTaskCreate(OWP_SockClient, "owSockC", onewireSOCK_STACK, (void *) (intptr_t) Fd,
+			onewireSOCK_PRIO, NULL) != pdPASS) {
+			SL_ERR("no client task fd=%d", Fd);
+			close(Fd);
+		}
+	}
+	vTaskDelete(NULL);
+}
+
+// ###################################### Public function ##########################################
+
+int	OWP_SockStart(void) {
+	struct sockaddr_un sAddr = { .sun_family = AF_UNIX };
+	strncpy(sAddr.sun_path, onewireSOCK_PATH, sizeof(sAddr.sun_path) - 1);
+	int Srv = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (Srv < 0)
+		return erFAILURE;
+	unlink(onewireSOCK_PATH);
+	if (bind(Srv, (struct sockaddr *) &sAddr, sizeof(sAddr)) < 0 || listen(Srv, 4) < 0) {
+		SL_ERR("bind/listen '%s' failed", onewireSOCK_PATH);
+		close(Srv);
+		return erFAILURE;
+	}
+	if (xTaskCreate(OWP_SockServer, "owSock", onewireSOCK_STACK, (void *) (intptr_t) Srv,
+		onewireSOCK_PRIO, NULL) != pdPASS) {
+		close(Srv);
+		return erFAILURE;
+	}
+	SL_INFO("Listening on '%s'", onewireSOCK_PATH);
+	return erSUCCESS;
+}
+#endif
@@ -1,18 +1,18 @@
 /*
- * owb_rmt.c - Copyright (c) 2020-24 Andre M. Maree / KSS Technologies (Pty) Ltd.
+ * owb_rmt.c - Copyright (c) 2020-26 Andre M. Maree / KSS Technologies (Pty) Ltd.
  */
 
 #include "hal_platform.h"
 
 #if (halRMT_1W > 0)
-#include "FreeRTOS_Support.h"
+#include "hal_memory.h"
 #include "onewire_platform.h"
-#include "hal_options.h"
-#include "report.h.h"
+#include "report.h"
 #include "syslog.h"
 #include "systiming.h"								// timing debugging
-#include "x_errors_events.h"
-#include "x_string_general.h"
+#include "errors_events.h"
+
+#include <string.h>
 
 // ###################################### General macros ###########################################
 
@@ -25,46 +25,258 @@
 
 // ######################################## Build macros ###########################################
 
+#ifndef halRMT_1W_GPIOS
+	#error "halRMT_1W_GPIOS (eg { 4, 5 }) must be defined by the board when halRMT_1W enabled"
+#endif
+
+#define	rmtOW_TIMEOUT				10				// mSec, longest batch (reset) is ~1mS
 
 // ##################################### Local structures ##########################################
 
+/* All durations in RMT ticks (0.1uS), from AN126 table 2 (recommended values).
+ * Write/read slots are a low (A or C) followed by a high (B or D) pulse, a read slot is a write 1
+ * slot with the bit value decoded from the LENGTH of the low pulse seen on the RX loop back: the
+ * device extends the low for a 0, the threshold is the master sample point (A + E).
+ * The RX idle threshold ends a receive: it must exceed the longest level in the batch (H for a
+ * reset, B for bit slots), shorter values end the receive (and the transaction) sooner. */
+typedef struct rmtow_tim_t {
+	u16_t RstL, RstH;						// H, I + J
+	u16_t W1L, W1H, W0L, W0H;				// A, B, C, D
+	u16_t Rthr;								// A + E
+	u32_t IdleRst, IdleBit;					// RX idle (nSec) for reset & bit batches
+} rmtow_tim_t;
 
 // ###################################### Local variables ##########################################
 
+static const rmtow_tim_t rmtOWTim[2] = {
+	[owSPEED_STANDARD]	= { 4800, 4800, 60, 640, 600, 100, 150, 600000, 80000 },
+	[owSPEED_ODRIVE]	= {  700,  485, 10,  75,  75,  25,  20,  90000, 10000 },
+};
 
 // ##################################### Global variables ##########################################
 
 u8_t rmtCount	= 0;
 owb_rmt_t * psaRMT = NULL;
 
-// ##################################### Forward declarations ######################################
+// #################################### RMT transaction support ####################################
+
+static bool IRAM_ATTR rmtOWRxDoneCB(rmt_channel_handle_t hRx, const rmt_rx_done_event_data_t * psEvt, void * pvArg) {
+	owb_rmt_t * psRMT = pvArg;
+	BaseType_t bWoken = pdFALSE;
+	size_t Num = psEvt->num_symbols;
+	xQueueSendFromISR(psRMT->hQue, &Num, &bWoken);
+	return bWoken == pdTRUE;
+}
+
+static void rmtOWSymbol(owb_rmt_t * psRMT, int Idx, u16_t Low, u16_t High) {
+	psRMT->sTx[Idx] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = Low, .level1 = 1, .duration1 = High };
+}
+
+/**
+ * @brief	Encode Num bit slots from pBuf (LSB first), 1 bits are also read slots
+ * @note	Num MUST be <= rmtOW_BATCH_BITS
+ */
+static void rmtOWEncode(owb_rmt_t * psRMT, const u8_t * pBuf, int Num) {
+	const rmtow_tim_t * psT = &rmtOWTim[psRMT->OD];
+	for (int i = 0; i < Num; ++i) {
+		if (pBuf[i >> 3] & (1 << (i & 7)))
+			rmtOWSymbol(psRMT, i, psT->W1L, psT->W1H);
+		else
+			rmtOWSymbol(psRMT, i, psT->W0L, psT->W0H);
+	}
+}
+
+/**
+ * @brief	Decode Num bit slots received (loop back) into pBuf (LSB first)
+ * @return	number of bits decoded, < Num if slots missing
+ */
+static int rmtOWDecode(owb_rmt_t * psRMT, u8_t * pBuf, int Num, int Rcvd) {
+	const rmtow_tim_t * psT = &rmtOWTim[psRMT->OD];
+	memset(pBuf, 0, (Num + 7) / 8);
+	if (Rcvd < Num)
+		Num = Rcvd;
+	for (int i = 0; i < Num; ++i) {
+		if (psRMT->sRx[i].duration0 < psT->Rthr)
+			pBuf[i >> 3] |= (1 << (i & 7));
+	}
+	return Num;
+}
+
+/**
+ * @brief	Transmit the first NumTx symbols in sTx while receiving the loop back into sRx
+ * @return	number of symbols received or erTIMEOUT/erFAILURE
+ */
+static int rmtOWXfer(owb_rmt_t * psRMT, int NumTx, u32_t Idle) {
+	const rmt_receive_config_t sRxCfg = { .signal_range_min_ns = 200, .signal_range_max_ns = Idle };
+	const rmt_transmit_config_t sTxCfg = { .loop_count = 0, .flags.eot_level = 1 };
+	size_t Num;
+	xQueueReset(psRMT->hQue);
+	if (rmt_receive(psRMT->hRx, psRMT->sRx, sizeof(psRMT->sRx), &sRxCfg) != ESP_OK ||
+		rmt_transmit(psRMT->hTx, psRMT->hEnc, psRMT->sTx, NumTx * sizeof(rmt_symbol_word_t), &sTxCfg) != ESP_OK)
+		return erFAILURE;
+	if (xQueueReceive(psRMT->hQue, &Num, pdMS_TO_TICKS(rmtOW_TIMEOUT)) != pdTRUE) {
+		SL_ERR("RMT GPIO=%d timeout", psRMT->Gpio);
+		return erTIMEOUT;
+	}
+	rmt_tx_wait_all_done(psRMT->hTx, rmtOW_TIMEOUT);
+	return Num;
+}
+
+/**
+ * @brief	Write (and read back) Num bits in batches of up to rmtOW_BATCH_BITS slots
+ * @note	Slots read as 0 on a transaction failure, a 1 written reads as 1 only if the bus is free
+ */
+static void rmtOWBits(owb_rmt_t * psRMT, u8_t * pBuf, int Num) {
+	const u32_t Idle = rmtOWTim[psRMT->OD].IdleBit;
+	u8_t Tmp[rmtOW_BATCH_BYTES + 1];
+	for (int Done = 0; Done < Num; ) {
+		int Cnt = Num - Done;
+		if (Cnt > (rmtOW_BATCH_BYTES * 8))
+			Cnt = rmtOW_BATCH_BYTES * 8;			// whole bytes, Done stays byte aligned
+		rmtOWEncode(psRMT, &pBuf[Done / 8], Cnt);
+		int iRV = rmtOWXfer(psRMT, Cnt, Idle);
+		rmtOWDecode(psRMT, Tmp, Cnt, iRV > 0 ? iRV : 0);
+		memcpy(&pBuf[Done / 8], Tmp, (Cnt + 7) / 8);
+		Done += Cnt;
+	}
+}
 
+// #################################### RMT debug/reporting ########################################
 
-// #################################### DS248x debug/reporting #####################################
+int rmtOWReport(report_t * psR, owb_rmt_t * psRMT) {
+	return xReport(psR, "RMT 1W GPIO=%d  OD=%d  Batch=%dB\r\n", psRMT->Gpio, psRMT->OD, rmtOW_BATCH_BYTES);
+}
 
-void ow_rmtReport(report_t * psR, owb_rmt_t * psRMT) {}
+int rmtOWReportAll(report_t * psR) {
+	int iRV = 0;
+	for (int i = 0; i < rmtCount; iRV += rmtOWReport(psR, &psaRMT[i++]));
+	return iRV;
+}
 
-void ow_rmtReportAll(report_t * psR) {}
+// ################################### RMT 1-Wire bus functions ####################################
 
-// ################################## DS248x-x00 1-Wire functions ##################################
+int	rmtOWBusSelect(owb_rmt_t * psRMT) {
+	xRtosSemaphoreTake(&psRMT->mux, portMAX_DELAY);
+	return 1;
+}
 
-int	rmtOWReset(owb_rmt_t * psRMT) { esp_err_t onewire_bus_reset(onewire_bus_handle_t handle); }
+void rmtOWBusRelease(owb_rmt_t * psRMT) { xRtosSemaphoreGive(&psRMT->mux); }
 
-int	rmtOWSpeed(owb_rmt_t * psRMT, bool speed) {}
+int	rmtOWReset(owb_rmt_t * psRMT) {
+	const rmtow_tim_t * psT = &rmtOWTim[psRMT->OD];
+	rmtOWSymbol(psRMT, 0, psT->RstL, psT->RstH);
+	int iRV = rmtOWXfer(psRMT, 1, psT->IdleRst);
+	/* [0] = reset low & wait high, [1] = presence low (if any), anything shorter than a
+	 * presence pulse has been removed by the glitch filter. */
+	return (iRV >= 2 && psRMT->sRx[1].level0 == 0) ? 1 : 0;
+}
 
-int	rmtOWLevel(owb_rmt_t * psRMT, bool level) {}
+int	rmtOWSpeed(owb_rmt_t * psRMT, bool speed) {
+	psRMT->OD = speed;
+	return psRMT->OD;
+}
 
-bool rmtOWWriteBit(owb_rmt_t * psRMT, bool Bit) { esp_err_t onewire_bus_write_bit(onewire_bus_handle_t handle, uint8_t tx_bit); }
+bool rmtOWTouchBit(owb_rmt_t * psRMT, bool bit) {
+	u8_t Byte = bit;
+	rmtOWBits(psRMT, &Byte, 1);
+	return Byte & 1;
+}
 
-bool rmtOWReadBit(owb_rmt_t * psRMT, bool Bit) { esp_err_t onewire_bus_read_bit(onewire_bus_handle_t handle, uint8_t *rx_bit); }
+u8_t rmtOWWriteByte(owb_rmt_t * psRMT, u8_t sendbyte) {
+	rmtOWBits(psRMT, &sendbyte, 8);
+	return sendbyte;
+}
 
-u8_t rmtOWWriteByte(owb_rmt_t * psRMT, u8_t Byte) {}
+u8_t rmtOWReadByte(owb_rmt_t * psRMT) { return rmtOWWriteByte(psRMT, 0xFF); }
 
-u8_t rmtOWWriteBytes(owb_rmt_t * psRMT, u8_t * Bytes) {
-	esp_err_t onewire_bus_read_bytes(onewire_bus_handle_t handle, uint8_t *rx_data, size_t rx_data_size)
+void rmtOWWriteBlock(owb_rmt_t * psRMT, u8_t * pBuf, int Len) {
+	u8_t Tmp[Len];									// write only, bits read back are discarded
+	memcpy(Tmp, pBuf, Len);
+	rmtOWBits(psRMT, Tmp, Len * 8);
 }
 
-u8_t rmtOWReadByte(owb_rmt_t * psRMT) {}
+void rmtOWReadBlock(owb_rmt_t * psRMT, u8_t * pBuf, int Len) {
+	memset(pBuf, 0xFF, Len);
+	rmtOWBits(psRMT, pBuf, Len * 8);
+}
+
+// ##################################### Backend ops table #########################################
+
+static int rmtOpsSelect(u8_t DevNum, u8_t Bus, u8_t Pri) { return rmtOWBusSelect(&psaRMT[DevNum]); }
+static void rmtOpsRelease(u8_t DevNum) { rmtOWBusRelease(&psaRMT[DevNum]); }
+static int rmtOpsReset(u8_t DevNum) { return rmtOWReset(&psaRMT[DevNum]); }
+static bool rmtOpsTouchBit(u8_t DevNum, bool Bit) { return rmtOWTouchBit(&psaRMT[DevNum], Bit); }
+static u8_t rmtOpsWriteByte(u8_t DevNum, u8_t Byte) { return rmtOWWriteByte(&psaRMT[DevNum], Byte); }
+static u8_t rmtOpsReadByte(u8_t DevNum) { return rmtOWReadByte(&psaRMT[DevNum]); }
+static void rmtOpsWriteBlock(u8_t DevNum, u8_t * pBuf, int Len) { rmtOWWriteBlock(&psaRMT[DevNum], pBuf, Len); }
+static void rmtOpsReadBlock(u8_t DevNum, u8_t * pBuf, int Len) { rmtOWReadBlock(&psaRMT[DevNum], pBuf, Len); }
+static int rmtOpsSpeed(u8_t DevNum, bool Spd) { return rmtOWSpeed(&psaRMT[DevNum], Spd); }
+
+/* Single bus per GPIO, nothing to yield to. No strong pull-up, parasite powered devices can
+ * NOT convert on an RMT bus (Level absent). Triplet is composed in software by OWSearch. */
+const ow_ops_t rmtOps = {
+	.Select = rmtOpsSelect,			.Release = rmtOpsRelease,
+	.Reset = rmtOpsReset,			.TouchBit = rmtOpsTouchBit,
+	.WriteByte = rmtOpsWriteByte,	.ReadByte = rmtOpsReadByte,
+	.WriteBlock = rmtOpsWriteBlock,	.ReadBlock = rmtOpsReadBlock,
+	.Speed = rmtOpsSpeed,
+	.Caps = owCAP_OVERDRIVE,
+};
 
-u8_t rmtOWSearchTriplet(owb_rmt_t * psRMT, u8_t u8Dir) {}
+// ###################################### Configuration ############################################
+
+static int rmtOWInit(owb_rmt_t * psRMT, u8_t Gpio) {
+	/* RX MUST be created first, TX then shares the pad in open drain with loop back. */
+	const rmt_rx_channel_config_t sRxCfg = {
+		.gpio_num = Gpio, .clk_src = RMT_CLK_SRC_DEFAULT, .resolution_hz = rmtOW_RES_HZ,
+		.mem_block_symbols = rmtOW_MEM_SYMBOLS,
+	};
+	const rmt_tx_channel_config_t sTxCfg = {
+		.gpio_num = Gpio, .clk_src = RMT_CLK_SRC_DEFAULT, .resolution_hz = rmtOW_RES_HZ,
+		.mem_block_symbols = rmtOW_MEM_SYMBOLS, .trans_queue_depth = 2,
+		.flags.io_loop_back = 1, .flags.io_od_mode = 1,
+	};
+	const rmt_rx_event_callbacks_t sCB = { .on_recv_done = rmtOWRxDoneCB };
+	const rmt_copy_encoder_config_t sEncCfg = { 0 };
+	psRMT->Gpio = Gpio;
+	psRMT->hQue = xQueueCreate(1, sizeof(size_t));
+	if (psRMT->hQue == NULL)
+		return erNO_MEM;
+	esp_err_t iRV = rmt_new_rx_channel(&sRxCfg, &psRMT->hRx);
+	if (iRV == ESP_OK)
+		iRV = rmt_new_tx_channel(&sTxCfg, &psRMT->hTx);
+	if (iRV == ESP_OK)
+		iRV = rmt_new_copy_encoder(&sEncCfg, &psRMT->hEnc);
+	if (iRV == ESP_OK)
+		iRV = rmt_rx_register_event_callbacks(psRMT->hRx, &sCB, psRMT);
+	if (iRV == ESP_OK)
+		iRV = rmt_enable(psRMT->hRx);
+	if (iRV == ESP_OK)
+		iRV = rmt_enable(psRMT->hTx);
+	if (iRV != ESP_OK) {
+		SL_ERR("RMT GPIO=%d failed (%s)", Gpio, esp_err_to_name(iRV));
+		return erFAILURE;
+	}
+	#if (HAL_DS18X20 > 0)
+		void ds18x20StepThreeRead(TimerHandle_t);
+		psRMT->th = xTimerCreateStatic("tmrRMT1W", pdMS_TO_TICKS(5), pdFALSE, NULL, ds18x20StepThreeRead, &psRMT->ts);
+	#endif
+	return erSUCCESS;
+}
+
+int	rmtOWConfig(void) {
+	static const u8_t Gpio[] = halRMT_1W_GPIOS;
+	const int Num = sizeof(Gpio) / sizeof(Gpio[0]);
+	if (psaRMT == NULL) {
+		psaRMT = pvOWP_ArenaAlloc(Num * sizeof(owb_rmt_t));
+		if (psaRMT == NULL)
+			return erNO_MEM;
+	}
+	for (int i = 0; i < Num; ++i) {					// failed GPIOs are skipped, not counted
+		if (rmtOWInit(&psaRMT[rmtCount], Gpio[i]) == erSUCCESS)
+			++rmtCount;
+	}
+	SL_INFO("RMT 1W %d/%d buses", rmtCount, Num);
+	return rmtCount;
+}
 #endif
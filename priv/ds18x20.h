@@ -6,6 +6,33 @@
 extern "C" {
 #endif
 
+// ################################## DS18X20 1-Wire Commands ######################################
+
+#define	DS18X20_CONVERT				0x44
+#define	DS18X20_COPY_SP				0x48
+#define	DS18X20_WRITE_SP			0x4E
+#define	DS18X20_READ_PSU			0xB4
+#define	DS18X20_RECALL_EE			0xB8
+#define	DS18X20_READ_SP				0xBE
+
+// ########################################### Macros ##############################################
+
+/* Raw values are the signed scratchpad temperature register: 1/16 C per LSB for family 28 (DS18B20),
+ * 1/2 C per LSB for family 10 (DS18S20). Divide by ds18x20RAW_DIV() for degrees C. */
+#define	ds18x20RAW_DIV(psX)			(((psX)->sOW.ROM.HexChars[owFAMILY] == OWFAMILY_10) ? 2 : 16)
+
+#ifndef ds18x20HIST_SIZE
+	#define	ds18x20HIST_SIZE		32		// history slots (2 bytes each) per sensor, 0 = disabled
+#endif
+
+#ifndef ds18x20READ_STACK
+	#define	ds18x20READ_STACK		3072	// step 3 read task: ReadSP, convert & publish
+#endif
+
+#ifndef ds18x20READ_PRIO
+	#define	ds18x20READ_PRIO		configTIMER_TASK_PRIORITY	// where step 3 used to run
+#endif
+
 // ######################################## Enumerations ###########################################
 
 // ######################################### Structures ############################################
@@ -34,15 +61,57 @@ typedef struct __attribute__((packed)) {				// DS1820/S20/B20 9/12 bit Temp sens
 	struct __attribute__((packed)) {
 		u8_t Idx : 3;				// Endpoint index (0->7) of this specific device
 		u8_t Res : 2;				// Resolution 0=9b 1=10b 2=11b 3=12b
-		u8_t SBits : 3;
+		u8_t Due : 1;				// sample due in the current sense cycle
+		u8_t Pub : 1;				// 1 = value published at least once
+		u8_t SBits : 1;
 	};
+	u32_t Tper;						// sampling period (mSec) configured for THIS sensor
+	TickType_t Tdue;				// tick at which the next sample is due
+	TickType_t Tlast;				// tick at which the value was last published
+	i16_t Tpub;						// raw value last published
+	u16_t Tmax;						// max silence (Sec), publish even if unchanged
+	u8_t Dband;						// deadband (raw units), min change to publish, 0 = every sample
+	TickType_t Tsmpl;				// tick of the last good sample, cached read freshness
+	u8_t Upd;						// 1 = published since last ds18x20Updated()
 } ds18x20_t;
-DUMB_STATIC_ASSERT(sizeof(ds18x20_t) == 54);
+DUMB_STATIC_ASSERT(sizeof(ds18x20_t) == 72 + sizeof(TickType_t));
+
+typedef struct ds18x20smpl_t { seconds_t Tsec; i16_t Traw; } ds18x20smpl_t;
+
+typedef struct ds18x20stat_t {			// aggregates over a window of the samples held in history
+	seconds_t Tfirst, Tlast;
+	i16_t Vmin, Vmax, Vavg;				// raw units, see ds18x20RAW_DIV()
+	u16_t Count;
+} ds18x20stat_t;
+
+#if (ds18x20HIST_SIZE > 0)
+typedef union ds18x20rec_t {			// history slot, delta to previous sample OR escape payload
+	struct __attribute__((packed)) {
+		s8_t dV;						// delta value (raw units), ds18x20HIST_ESC = escape
+		u8_t dT;						// delta time (Sec)
+	};
+	i16_t V;							// escape slot 1: absolute value
+	u16_t T;							// escape slot 2: delta time (Sec)
+} ds18x20rec_t;
+DUMB_STATIC_ASSERT(sizeof(ds18x20rec_t) == 2);
+
+typedef struct __attribute__((packed)) ds18x20hist_t {
+	seconds_t Tbase, Thead;				// time of oldest & newest sample
+	i32_t Sum;							// running sum of all samples held
+	i16_t Vbase, Vhead;					// value of oldest & newest sample
+	i16_t Vmin, Vmax;
+	u16_t Count;						// samples held, base + 1 per record
+	u8_t Tail, Used;					// slot of oldest record & slots in use
+	ds18x20rec_t Rec[ds18x20HIST_SIZE];
+} ds18x20hist_t;
+DUMB_STATIC_ASSERT(sizeof(ds18x20hist_t) == (24 + (2 * ds18x20HIST_SIZE)));
+#endif
 
 // ###################################### Public variables #########################################
 
 #if (HAL_DS18X20 > 0)
 	extern u8_t Fam10Count, Fam28Count;
+	extern ds18x20_t * psaDS18X20;
 #endif
 
 // ###################################### Public functions #########################################
@@ -59,10 +128,53 @@ int	ds18x20WriteEE(ds18x20_t * psDS18X20);;
 
 int	ds18x20Initialize(ds18x20_t * psDS18X20);;
 int	ds18x20ResetConfig(ds18x20_t * psDS18X20);;
+int	ds18x20SetDeadband(int Xcur, int Xmax, int Dband, int Tmax);
+
+/**
+ * @brief	Test & clear the "published since last call" flag of sensor Idx
+ * @return	1 if a new value was published, 0 if not (sense/log of the sub-endpoint can be
+ *			skipped), erINV_INDEX if no such sensor
+ */
+int	ds18x20Updated(int Idx);
+
+typedef struct ds18x20cache_t {		// cached read service statistics
+	u32_t Hit;						// answered from cache
+	u32_t Miss;						// caused a bus convert & read pass
+	u32_t Coal;						// missed, but answered by a pass another caller ran
+	u32_t Fail;						// pass failed, value not refreshed
+} ds18x20cache_t;
+
+/**
+ * @brief	Read sensor Idx, from cache if the last sample is no older than MaxAge mSec
+ * @param	pRaw - set to the raw value, divide by ds18x20RAW_DIV() for degrees C
+ * @return	erSUCCESS, erINV_STATE if not enumerated, erINV_INDEX or erFAILURE if the bus pass failed
+ * @note	A miss converts & reads every sensor on the bus in one pass. Concurrent misses on the
+ *			same bus wait for that pass instead of starting their own.
+ * @note	A miss only refreshes the scratchpad & sample time, publishing and history remain with
+ *			the sense scheduler.
+ */
+int	ds18x20ReadCached(int Idx, u32_t MaxAge, i16_t * pRaw);
+void ds18x20CacheStats(ds18x20cache_t * psStats);
+
+#if (ds18x20HIST_SIZE > 0)
+/**
+ * @brief	Copy samples in time window [Tfrom, Tto] from history of sensor Idx, oldest first
+ * @return	number of samples copied (up to Size) or erINV_VALUE if invalid sensor
+ */
+int	ds18x20HistRead(int Idx, seconds_t Tfrom, seconds_t Tto, ds18x20smpl_t * psBuf, int Size);
+
+/**
+ * @brief	Return min/max/mean aggregates over the samples in time window [Tfrom, Tto] of sensor Idx
+ * @return	number of samples in the window or erINV_VALUE if invalid sensor
+ * @note	A window covering the whole history uses the running aggregates, O(1)
+ */
+int	ds18x20HistStats(int Idx, seconds_t Tfrom, seconds_t Tto, ds18x20stat_t * psStat);
+#endif
 
 // ##################################### I2C Task support ##########################################
 
 struct rule_t;
+int	ds18x20ConfigRange(int Xcur, int Xmax, int lo, int hi, int res, int wr);
 int	ds18x20ConfigMode (struct rule_t *, int Xcur, int Xmax);
 int	ds18x20Enumerate(void);
 
@@ -71,6 +183,12 @@ int	ds18x20Sense(epw_t * psEWP);;
 int	ds18x20StartAllInOne(struct epw_t * psEPW);;
 
 int ds18x20ReportAll(struct report_t * psR);
+
+struct owsnap_wr_t;
+/**
+ * @brief	Append the owsnapSEC_TEMP section to a snapshot, see OWP_Snapshot()
+ */
+void ds18x20Snapshot(struct owsnap_wr_t * psW);
 int	ds18x20EnumerateCB(struct report_t * psR, owdi_t * psOW);
 int	ds18x20Print_CB(struct report_t * psR, ds18x20_t * psDS18X20);
 
@@ -7,15 +7,138 @@ extern "C" {
 #endif
 
 // ############################################# Macros ############################################
+
+#ifndef ds1990xLATENCY							// touch-to-event latency histogram per channel
+	#define ds1990xLATENCY		(appPRODUCTION == 0)	// default: on in DEBUG builds; set 0/1 to force
+#endif
+
+#ifndef ds1990xLRU_SIZE
+	#define	ds1990xLRU_SIZE		4			// recent tags remembered per channel for repeat suppression
+#endif
+
+#ifndef ds1990xEVT_SIZE
+	#define	ds1990xEVT_SIZE		16			// tag event ring entries, power of 2
+#endif
+
+#ifndef ds1990xBLOOM_BPT
+	#define	ds1990xBLOOM_BPT	10			// authorised tag prefilter bits per tag, ~1% false positives
+#endif
+
+#ifndef ds1990xBLOOM_MAX
+	#define	ds1990xBLOOM_MAX	(1UL << 20)	// prefilter bits cap (128KB), power of 2
+#endif
+
+#ifndef ds1990xNO_READER						// logical buses (bit per bus) that cannot host a reader
+	#define	ds1990xNO_READER	0ULL		// default: any bus may, only these poll at the STATIC rate
+#endif
+
+#ifndef ds1990xAUTH_LOAD
+	#define	ds1990xAUTH_LOAD	1			// load the authorised tags from ds1990xAUTH_PART at config
+#endif
+
+#ifndef ds1990xAUTH_PART
+	#define	ds1990xAUTH_PART	"owtags"	// data partition label
+#endif
+
+#define	ds1990xAUTH_MAGIC		0x4754574FUL	// "OWTG", partition header: Magic, Count, sorted u64 ROMs
+
 // ######################################## Enumerations ###########################################
+
+enum { ds1990xAUTH_NONE, ds1990xAUTH_DENY, ds1990xAUTH_ALLOW };	// no index loaded / result
 // ######################################### Structures ############################################
+
+typedef struct __attribute__((packed)) ds1990xtag_t {	// recently seen tag
+	u64_t ROM;							// 0 = unused entry
+	seconds_t Tacc;						// last ACCEPTED (reported) read
+	seconds_t Tseen;					// last read, accepted or suppressed, LRU order
+	u16_t Hits;							// reads since entry created
+	u8_t Auth;							// ds1990xAUTH_? result of the last accepted read
+} ds1990xtag_t;
+DUMB_STATIC_ASSERT(sizeof(ds1990xtag_t) == 19);
+
+typedef struct __attribute__((packed)) ds1990xevt_t {	// accepted tag read
+	u64_t ROM;
+	seconds_t Time;
+	u32_t Seq;							// per event produced, a gap = events lost to overflow
+	u8_t LogChan;
+	u8_t Auth;							// ds1990xAUTH_?
+} ds1990xevt_t;
+DUMB_STATIC_ASSERT(sizeof(ds1990xevt_t) == 18);
+
+#if (ds1990xLATENCY > 0)
+#define	ds1990xLAT_BUCKETS		10
+typedef struct ds1990xlat_t {			// latency of the last touch & histogram of all touches
+	TickType_t Tempty;					// start of the last poll without a tag, the touch came later
+	TickType_t Tpres;					// start of the poll that found the tag
+	TickType_t Tvalid;					// ROM read & CRC valid, handler called
+	TickType_t Tpost;					// event posted
+	u32_t Max;							// mSec, last empty poll to posted
+	u32_t Num;							// touches measured
+	u16_t Cnt[ds1990xLAT_BUCKETS];		// per bucket, see ds1990xLatBound[]
+	u8_t Present;						// previous poll found a tag, next is NOT a new touch
+	u8_t Empty;							// Tempty valid, a tag present since boot is not measured
+} ds1990xlat_t;
+#endif
+
+typedef struct ds1990x_t {				// per LOGICAL channel polling state
+	TickType_t Tnext;					// tick at which the channel is next polled
+	TickType_t Thot;					// tick until which the channel is polled at the fast rate
+	u16_t Tbkof;						// error backoff period (mSec), 0 = channel healthy
+	u16_t ErrPrv;						// channel error count at the previous poll
+	ds1990xtag_t Tag[ds1990xLRU_SIZE];	// recent tags, least recently seen replaced first
+#if (ds1990xLATENCY > 0)
+	ds1990xlat_t sLat;
+#endif
+} ds1990x_t;
 // ###################################### Public variables #########################################
 // ###################################### Public functions #########################################
 
 void ds1990xConfig(void);
+
+/**
+ * @brief	Replace the authorised tag set, in use from the next lookup
+ * @param	pTags - ROM values sorted ascending (no duplicates), normally flash resident, must
+ *			remain valid until replaced by a subsequent call
+ * @param	Count - number of tags, 0 = deny all
+ * @return	erSUCCESS, erINV_VALUE if not sorted or erNO_MEM if no memory for the prefilter
+ * @note	Single writer, the previous set is no longer referenced once this returns. The Bloom
+ *			prefilter is sized from Count, ds1990xBLOOM_BPT bits per tag up to ds1990xBLOOM_MAX.
+ */
+int	ds1990xAuthSet(const u64_t * pTags, u32_t Count);
+
+/**
+ * @brief	Check a tag against the authorised set
+ * @return	ds1990xAUTH_ALLOW/_DENY or _NONE if no set loaded
+ */
+int	ds1990xAuthCheck(u64_t ROM);
+
+/**
+ * @brief	Make hTask the (single) consumer of the tag event ring, NULL to stop queueing events
+ * @note	Called by the consumer task itself, events queued before are discarded. While
+ *			subscribed the ring going from empty to non-empty notifies hTask with the channel bit
+ *			(evtFIRST_OW + LogChan) of that first event, instead of the Events task per read.
+ */
+void ds1990xEventSubscribe(TaskHandle_t hTask);
+
+/**
+ * @brief	Drain up to Max tag events, oldest first, by the subscribed task only
+ * @return	number of events copied
+ * @note	After a notification call this until it returns 0, no further notification is sent
+ *			while events remain queued.
+ */
+int	ds1990xEventGet(ds1990xevt_t * psEvt, int Max);
+
+/**
+ * @brief	Return the number of tag events lost because the ring was full
+ */
+u32_t ds1990xEventLost(void);
+
 struct epw_t;
 int	ds1990Sense(struct epw_t * psEWP);
 
+struct report_t;
+int	ds1990xReportAll(struct report_t * psR);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,143 @@
+// ds2480b.h - Copyright (c) 2026 Andre M. Maree / KSS Technologies (Pty) Ltd.
+
+#pragma once
+
+#if (HAL_DS2480B > 0)
+#include "driver/uart.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ############################## DS2480B mode & command bytes (AN192) #############################
+
+#define	ds2480bMODE_DATA			0xE1
+#define	ds2480bMODE_COMMAND			0xE3				// in data mode MUST be sent twice to be data
+#define	ds2480bMODE_STOP_PULSE		0xF1
+#define	ds2480bTIMING_BYTE			0xC1				// calibrates the DS2480B to the host baud rate
+
+#define	ds2480bCMD_COMM				0x81
+#define	ds2480bCMD_CONFIG			0x01
+
+#define	ds2480bFUNC_BIT				0x00
+#define	ds2480bFUNC_SEARCHON		0x30
+#define	ds2480bFUNC_SEARCHOFF		0x20
+#define	ds2480bFUNC_RESET			0x40
+#define	ds2480bFUNC_CHMOD			0x60
+
+#define	ds2480bBITPOL_ONE			0x10
+#define	ds2480bPRIME5V				0x02
+
+#define	ds2480bSPEED_STD			0x00
+#define	ds2480bSPEED_FLEX			0x04
+#define	ds2480bSPEED_OD				0x08
+#define	ds2480bSPEED_PULSE			0x0C
+
+#define	ds2480bPARM_READ			0x00
+#define	ds2480bPARM_SLEW			0x10
+#define	ds2480bPARM_5VPULSE			0x30
+#define	ds2480bPARM_WRITE1LOW		0x40
+#define	ds2480bPARM_SAMPLEOFFSET	0x50
+#define	ds2480bPARM_BAUDRATE		0x70
+
+#define	ds2480bSET_INFINITE			0x0E
+#define	ds2480bSET_9600				0x00
+#define	ds2480bSET_19200			0x02
+#define	ds2480bSET_57600			0x04
+#define	ds2480bSET_115200			0x06
+
+#define	ds2480bRB_RESET_MASK		0x03				// reset response
+#define	ds2480bRB_PRESENCE			0x01
+#define	ds2480bRB_ALARMPRESENCE		0x02
+#define	ds2480bRB_BIT_MASK			0x03				// single bit response
+#define	ds2480bRB_BIT_ONE			0x03
+
+// ############################################# Macros ############################################
+
+/* FLEX (standard speed) timing, AN192 recommended values for long lines:
+ * PDSRC (slew) 1.37V/uS, W1LT (write 1 low) 10uS, DSO/WORT (sample offset) 8uS */
+#ifndef ds2480bSLEW
+	#define	ds2480bSLEW				0x06
+#endif
+#ifndef ds2480bW1LT
+	#define	ds2480bW1LT				0x04
+#endif
+#ifndef ds2480bDSO
+	#define	ds2480bDSO				0x0A
+#endif
+
+#ifndef ds2480bBAUD
+	#define	ds2480bBAUD				ds2480bSET_115200	// operating rate, detect is always at 9600
+#endif
+
+#define	ds2480bBLOCK_MAX			64					// bytes streamed per UART exchange
+
+// ######################################### Structures ############################################
+
+#if (HAL_DS2480B > 0)
+typedef struct ds2480b_t {				// DS2480B serial 1-Wire line driver, a single bus
+	SemaphoreHandle_t mux;
+	StaticTimer_t ts;
+	#if (HAL_DS18X20 > 0)
+	TimerHandle_t th;
+	#endif
+	u32_t ErrCnt;						// failed exchanges, each followed by a resync
+	u8_t Port;							// UART number
+	u8_t Lo;							// logical bus number, see OWP_Config()
+	u8_t Mode;							// ds2480bMODE_DATA / ds2480bMODE_COMMAND
+	u8_t Speed;							// ds2480bSPEED_FLEX / ds2480bSPEED_OD
+	u8_t Baud;							// ds2480bSET_?
+	u8_t SPU:1;							// strong pull-up armed, applied after the next byte
+	u8_t Pulse:1;						// strong pull-up active
+	u8_t Spare:6;
+} ds2480b_t;
+
+// #################################### Public Data structures #####################################
+
+extern u8_t ds2480bCount;
+extern ds2480b_t * psaDS2480B;
+extern const ow_ops_t ds2480bOps;
+
+// ###################################### Device debug support #####################################
+
+struct report_t;
+int	ds2480bReport(struct report_t * psR, ds2480b_t * psDS2480B);
+int	ds2480bReportAll(struct report_t * psR);
+
+// #################################### 1-Wire support functions ###################################
+
+/**
+ * @brief	Open each UART in halDS2480B_UARTS, detect the DS2480B & switch to ds2480bBAUD
+ * @return	number of buses configured
+ */
+int	ds2480bConfig(void);
+
+int	ds2480bBusSelect(ds2480b_t * psDS2480B);
+void ds2480bBusRelease(ds2480b_t * psDS2480B);
+
+int	ds2480bOWReset(ds2480b_t * psDS2480B);
+int	ds2480bOWSpeed(ds2480b_t * psDS2480B, bool speed);
+int	ds2480bOWLevel(ds2480b_t * psDS2480B, bool level);
+bool ds2480bOWTouchBit(ds2480b_t * psDS2480B, bool bit);
+u8_t ds2480bOWWriteByte(ds2480b_t * psDS2480B, u8_t sendbyte);
+u8_t ds2480bOWReadByte(ds2480b_t * psDS2480B);
+void ds2480bOWWriteBlock(ds2480b_t * psDS2480B, u8_t * pBuf, int Len);
+void ds2480bOWReadBlock(ds2480b_t * psDS2480B, u8_t * pBuf, int Len);
+int	ds2480bOWSearch(ds2480b_t * psDS2480B, u8_t LD, ow_rom_t * psROM, u64_t * pDisc);
+
+// ##################################### Host (linux) stand-in #####################################
+
+#if (ds248xSIMULATE > 0) && defined(__linux__)
+/**
+ * @brief	Start a DS2480B stand-in on a pseudo-terminal, 1-Wire devices from the DS248x simulator
+ * @return	path of the slave side, for uart_host_path(), NULL if failed
+ */
+const char * pcDS2480B_PtyOpen(void);
+void ds2480bPtyClose(void);
+#endif
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -66,6 +66,18 @@ enum {													// STATus register bitmap
 	#define ds248xCHAN_ATTRIB	(appPRODUCTION == 0)	// default: on in DEBUG builds; set 0/1 to force
 #endif
 
+#ifndef ds248xSIMULATE									// virtual DS248x + 1-Wire population, NO I2C traffic
+	#define ds248xSIMULATE		0						// default: off; see ds248xsim.c
+#endif
+
+#ifndef ds248xTRACE										// binary I2C transaction trace ring, runtime enabled
+	#define ds248xTRACE			1						// default: built in, off until ds248xTraceCtrl()
+#endif
+
+#ifndef ds248xTRACE_SIZE
+	#define ds248xTRACE_SIZE	64						// records, power of 2, 16 bytes each
+#endif
+
 // ######################################### Structures ############################################
 
 // See http://www.catb.org/esr/structure-packing/
@@ -89,6 +101,7 @@ typedef union __attribute__((packed)) {
 typedef struct __attribute__((packed)) ds248x_t {		// DS248X I2C <> 1Wire bridge
 	struct i2c_di_t * psI2C;		// size = 4
 	SemaphoreHandle_t mux;			// size = 4
+	EventGroupHandle_t eg;			// size = 4, created on 1st back off, see ds248xBusTake()
 #if (HAL_DS18X20 > 0)		        // size = 4
 	TimerHandle_t th;
 	#define DS18X20x1	sizeof(TimerHandle_t)
@@ -150,6 +163,9 @@ typedef struct __attribute__((packed)) ds248x_t {		// DS248X I2C <> 1Wire bridge
 	 * task sets this flag lock-free - two concurrent read-modify-writes on one byte lose updates.
 	 * Whole-byte stores cannot collide with neighbours. */
 	u8_t CfgPend;
+	/* Bus arbitration: tasks waiting for the bus lock per owPRI_? class. A holder yields at
+	 * transaction boundaries, and a taker backs off, while a HIGHER class is waiting. */
+	u8_t Want[owPRI_NUM];
 #if	(appPRODUCTION == 0)		    // 16 bytes
 	u8_t PrvStat[8];				// previous STAT reg
 	u8_t PrvConf[8];				// previous CONF reg
@@ -211,7 +227,7 @@ typedef struct __attribute__((packed)) ds248x_t {		// DS248X I2C <> 1Wire bridge
 	#define DS18X20x3	0
 #endif
 } ds248x_t;
-DUMB_STATIC_ASSERT(sizeof(ds248x_t) == (4+4+ DS18X20x1 + sizeof(StaticTimer_t) + 9+3+2+84+ DS248Xx4 + DS18X20x2 + DS18X20x3));	// +2 = CfgSet+CfgPend, 84 = health block (incl I5 backoff)
+DUMB_STATIC_ASSERT(sizeof(ds248x_t) == (4+4+4+ DS18X20x1 + sizeof(StaticTimer_t) + 9+3+2+3+84+ DS248Xx4 + DS18X20x2 + DS18X20x3));	// +2 = CfgSet+CfgPend, +3 = Want[], 84 = health block (incl I5 backoff)
 
 typedef union __attribute__((packed)) {
 	struct {
@@ -239,6 +255,7 @@ typedef union __attribute__((packed)) {
 // #################################### Public Data structures #####################################
 
 extern ds248x_t * psaDS248X;
+extern const ow_ops_t ds248xOps;
 
 // ################################ DS248X I2C Read/Write support ##################################
 
@@ -286,6 +303,7 @@ int	ds248xConfig(struct i2c_di_t * psI2C);
  * @brief		Select the 1-Wire bus on a DS2482-800.
  * @param[in]	psDS248X required device control/config/status structure
  * @param[in] 	Chan
+ * @param[in] 	Pri owPRI_? class, lock only taken once no higher class is waiting
  * @return		result from ds248xWriteDelayReadCheck(), 1 if bus selected
  *				0 if device not detected or failure to perform select
  *
@@ -294,7 +312,18 @@ int	ds248xConfig(struct i2c_di_t * psI2C);
  *	NS	0	300		75
  *	OD	0	300		75
  */
-int	ds248xBusSelect(ds248x_t * psDS248X, u8_t Chan);
+int	ds248xBusSelect(ds248x_t * psDS248X, u8_t Chan, u8_t Pri);
+
+/**
+ * @brief		At a transaction boundary, hand the bus to any waiting higher class and re-select
+ * @param[in]	psDS248X required device control/config/status structure
+ * @param[in] 	Chan & Pri as per ds248xBusSelect()
+ * @return		1 if bus (still or again) selected, else as per ds248xBusSelect()
+ *				In BOTH cases the lock is held, the caller must still call ds248xBusRelease()
+ * @note		ONLY where no 1-Wire state spans the boundary: strong pull-up off, next command
+ *				starts with a reset.
+ */
+int	ds248xBusYield(ds248x_t * psDS248X, u8_t Chan, u8_t Pri);
 
 /**
  * @brief		Select the 1-Wire bus on a DS2482-800.
@@ -407,6 +436,20 @@ int ds248xReport(struct report_t * psR, ds248x_t * psDS248X);
  */
 int ds248xReportAll(struct report_t * psR);
 
+struct owsnap_wr_t;
+/**
+ * @brief	Append the owsnapSEC_CHIP (and with ds248xSTAT_DEBUG owsnapSEC_ACT) sections to a
+ *			snapshot, see OWP_Snapshot()
+ */
+void ds248xSnapshot(struct owsnap_wr_t * psW);
+
+/**
+ * @brief	Return errors counted on a channel in the current health report window
+ * @note	ErrSupp[] is cleared each time the health line is emitted, callers tracking a trend
+ *			must treat a decrease as a new window.
+ */
+u16_t ds248xChanErrors(u8_t DevNum, u8_t PhyBus);
+
 #if (ds248xCHAN_ATTRIB > 0)
 /**
  * @brief	I-3: run any pending channel line-state audit (LL/SD/PPD sweep of all 8 channels).
@@ -425,6 +468,110 @@ void ds248xAuditRun(void);
 void ds248xLogCRC(u8_t DevNum, u8_t PhyBus);
 #endif
 
+#if (ds248xTRACE > 0)
+// ####################################### Transaction trace #######################################
+
+enum {													// ds248xTraceCtrl() Flags
+	ds248xTRC_ENA		= (1 << 0),						// record
+	ds248xTRC_FREEZE	= (1 << 1),						// stop recording on a health escalation
+};
+
+typedef struct __attribute__((packed)) ds248xtrc_t {	// one ds248xWriteDelayRead() call
+	u32_t Tstart;						// halTIMER_ReadRunTime() uSec, low 32 bits
+	u16_t Dur;							// uSec, saturates at 0xFFFF
+	u16_t Seq;							// record number, gaps = overwritten or filtered
+	u8_t Dev : 3;						// index into psaDS248X
+	u8_t Chan : 3;						// CurChan at the time
+	u8_t Spare : 2;
+	u8_t Cmd;							// ds248xCMD_? (Tx[0])
+	u8_t Tx[2];							// Tx[1..2], 0 if not sent
+	u8_t Rx[2];							// RegX[Rptr..] as returned
+	u8_t TxSize : 4;
+	u8_t Rptr : 4;						// ds248xREG_? the reply landed in
+	s8_t iRV;							// erSUCCESS, else clamped error code
+} ds248xtrc_t;
+DUMB_STATIC_ASSERT(sizeof(ds248xtrc_t) == 16);
+
+/**
+ * @brief	Set trace flags (ds248xTRC_?) and filters, clears the ring when enabling
+ * @param	DevMask bit per psaDS248X index, ChanMask bit per channel, Cmd 0 = all commands
+ */
+void ds248xTraceCtrl(u8_t Flags, u8_t DevMask, u8_t ChanMask, u8_t Cmd);
+
+/**
+ * @brief	Copy up to Max records, oldest first, without consuming them
+ * @return	number of records copied
+ */
+int	ds248xTraceGet(ds248xtrc_t * psTrc, int Max);
+
+int	ds248xTraceReport(struct report_t * psR);
+#endif
+
+#if (ds248xSIMULATE > 0)
+// ####################################### Simulator support #######################################
+
+typedef struct ds248xsim_stat_t {		// totals since boot or ds248xSimClear()
+	u64_t Tbus;							// simulated bus time (nSec), I2C bytes + 1-Wire operations
+	u32_t Xfers;						// I2C transactions
+	u32_t Resets;						// 1-Wire resets
+	u32_t Slots;						// 1-Wire time slots (bits)
+} ds248xsim_stat_t;
+
+/**
+ * @brief	Simulated replacement for halI2C_Queue(i2cWDR_B) in ds248xWriteDelayRead()
+ * @return	erSUCCESS, or erFAILURE where the real device would NACK
+ */
+int	ds248xSimXfer(struct i2c_di_t * psI2C, u8_t * pTxBuf, size_t TxSize, u8_t * pRxBuf, size_t RxSize);
+
+/**
+ * @brief	Add/remove a virtual device (eg iButton touch) on a channel of simulated DS248x DevIdx
+ * @return	erSUCCESS or erINV_INDEX/erNO_MEM/erINV_VALUE
+ */
+int	ds248xSimAttach(u8_t DevIdx, u8_t Chan, u64_t ROM);
+int	ds248xSimDetach(u8_t DevIdx, u8_t Chan, u64_t ROM);
+
+/**
+ * @brief	Reset or time slot on a channel of the virtual devices keyed by psI2C, without the
+ *			DS248x in between, for masters emulated by other means (eg the DS2480B pty stand-in)
+ * @return	presence detected / line level sampled
+ */
+bool ds248xSimLineReset(struct i2c_di_t * psI2C, u8_t Chan);
+bool ds248xSimLineSlot(struct i2c_di_t * psI2C, u8_t Chan, bool Wr);
+
+void ds248xSimStats(u8_t DevIdx, ds248xsim_stat_t * psStat);
+
+/**
+ * @brief	Count only transfers done for hTask (see OWP_ScanOwner()), NULL to count all again
+ * @note	Other tasks' transfers are still simulated, they just do not add to the statistics
+ */
+void ds248xSimOwner(TaskHandle_t hTask);
+void ds248xSimClear(void);
+int	ds248xSimReport(struct report_t * psR, u8_t DevIdx);
+
+#if (ds248xTRACE > 0)
+typedef struct ds248xsim_replay_t {		// outcome of replaying a captured trace
+	u64_t Tbus;							// replayed bus time (nSec), from the recorded durations
+	u32_t Num;							// records in the script
+	u32_t Used;							// records consumed
+	u32_t Diverge;						// transfers where Cmd/Tx differed from the record
+	u32_t First;						// index of the first divergence, Num if none
+	u32_t Extra;						// transfers issued after the script ran out
+} ds248xsim_replay_t;
+
+/**
+ * @brief	Script the simulated DS248x from a ds248xTraceGet() capture, NULL/0 to end replay
+ * @note	Each transfer consumes the next record for its device in lockstep: the recorded
+ *			register bytes and result are returned, the recorded duration is charged, and any
+ *			difference in command or data bytes is counted as a divergence. Once the
+ *			script is exhausted transfers fail, as on a dead bus.
+ * @note	psTrc must remain valid until replay ends.
+ */
+void ds248xSimReplay(const ds248xtrc_t * psTrc, int Num);
+void ds248xSimReplayResult(ds248xsim_replay_t * psRes);
+int	ds248xSimReplayReport(struct report_t * psR);
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,44 +2,81 @@
 
 #pragma once
 
+#if (halRMT_1W > 0)
+#include "driver/rmt_tx.h"
+#include "driver/rmt_rx.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// ############################################# Macros ############################################
+
+#define	rmtOW_RES_HZ			10000000		// 0.1uS resolution, required for overdrive timing
+
+#ifndef rmtOW_MEM_SYMBOLS
+	#define	rmtOW_MEM_SYMBOLS	SOC_RMT_MEM_WORDS_PER_CHANNEL	// 64 (ESP32) or 48 (S3/C3/C6)
+#endif
+
+/* RX without DMA is limited to a single memory block, a batch (single transmit/receive) is
+ * limited to that many bit slots less the end marker. */
+#define	rmtOW_BATCH_BITS		(rmtOW_MEM_SYMBOLS - 2)
+#define	rmtOW_BATCH_BYTES		(rmtOW_BATCH_BITS / 8)
+
 // ######################################## Enumerations ###########################################
 
 
 // ######################################### Structures ############################################
 
-typedef struct owb_rmt_t {
+#if (halRMT_1W > 0)
+typedef struct owb_rmt_t {				// GPIO (RMT) 1-Wire master, a single bus
 	SemaphoreHandle_t mux;
 	StaticTimer_t ts;
 	#if (HAL_DS18X20 > 0)
 	TimerHandle_t th;
 	#endif
+	rmt_channel_handle_t hTx, hRx;
+	rmt_encoder_handle_t hEnc;			// copy encoder, symbols are prebuilt in sTx
+	QueueHandle_t hQue;					// RX done (symbol count) from ISR callback
+	rmt_symbol_word_t sTx[rmtOW_MEM_SYMBOLS];
+	rmt_symbol_word_t sRx[rmtOW_MEM_SYMBOLS];
+	u8_t Gpio;
+	u8_t Lo;							// logical bus number, see OWP_Config()
+	u8_t OD;							// 1 = overdrive timing
 } owb_rmt_t;
 
 // #################################### Public Data structures #####################################
 
+extern u8_t rmtCount;
 extern owb_rmt_t * psaRMT;
+extern const ow_ops_t rmtOps;
 
 // ###################################### Device debug support #####################################
 
-int	owb_rmtReportRegister(owb_rmt_t * psDS248X, int Reg) ;
-void owb_rmtReport(owb_rmt_t * psDS248X) ;
-void owb_rmtReportAll(void) ;
-int	owb_rmtBusSelect(owb_rmt_t * psDS248X, u8_t Chan) ;
-void owb_rmtBusRelease(owb_rmt_t * psDS248X) ;
+struct report_t;
+int	rmtOWReport(struct report_t * psR, owb_rmt_t * psRMT);
+int	rmtOWReportAll(struct report_t * psR);
 
 // #################################### 1-Wire support functions ###################################
 
-int	rmtOWReset(owb_rmt_t * psDS248X) ;
-int	rmtOWSpeed(owb_rmt_t * psDS248X, bool speed) ;
-int	rmtOWLevel(owb_rmt_t * psDS248X, bool level) ;
-bool rmtOWTouchBit(owb_rmt_t * psDS248X, bool bit) ;
-u8_t rmtOWWriteByte(owb_rmt_t * psDS248X, u8_t sendbyte) ;
-u8_t rmtOWReadByte(owb_rmt_t * psDS248X);
-u8_t owb_rmtOWSearchTriplet(owb_rmt_t * psDS248X, u8_t u8Dir) ;
+/**
+ * @brief	Create RMT TX & RX channels (open drain, loop back) for each GPIO in halRMT_1W_GPIOS
+ * @return	number of buses configured
+ */
+int	rmtOWConfig(void);
+
+int	rmtOWBusSelect(owb_rmt_t * psRMT);
+void rmtOWBusRelease(owb_rmt_t * psRMT);
+
+int	rmtOWReset(owb_rmt_t * psRMT);
+int	rmtOWSpeed(owb_rmt_t * psRMT, bool speed);
+bool rmtOWTouchBit(owb_rmt_t * psRMT, bool bit);
+u8_t rmtOWWriteByte(owb_rmt_t * psRMT, u8_t sendbyte);
+u8_t rmtOWReadByte(owb_rmt_t * psRMT);
+void rmtOWWriteBlock(owb_rmt_t * psRMT, u8_t * pBuf, int Len);
+void rmtOWReadBlock(owb_rmt_t * psRMT, u8_t * pBuf, int Len);
+#endif
 
 #ifdef __cplusplus
 }
@@ -71,10 +71,13 @@ extern "C" {
 
 // ######################################## Enumerations ###########################################
 
-enum { owBUS_DS248x, owBUS_RMT };
+enum { owBUS_DS248x, owBUS_RMT, owBUS_DS2480B, owBUS_NUM };
 enum { owADDR_MATCH, owADDR_SKIP };
 enum { owSPEED_STANDARD, owSPEED_ODRIVE	};
 enum { owPOWER_STANDARD, owPOWER_STRONG	};
+enum { owPRI_BACKGROUND, owPRI_PERIODIC, owPRI_INTERACTIVE, owPRI_NUM };	// bus arbitration classes
+enum { owCAP_TRIPLET = 0x01, owCAP_OVERDRIVE = 0x02, owCAP_STRONG_PU = 0x04, owCAP_SEARCH = 0x08 };	// ow_ops_t.Caps
+enum { owTRIP_ID = 0x01, owTRIP_CMP = 0x02, owTRIP_DIR = 0x04 };	// search triplet result bits
 enum { owFAM28_RES9B, owFAM28_RES10B, owFAM28_RES11B, owFAM28_RES12B };
 enum { owFAMILY, owAD0, owAD1, owAD2, owAD3, owAD4, owAD5, owCRC };
 
@@ -94,11 +97,12 @@ typedef	struct __attribute__((packed)) owdi_t {
 	struct __attribute__((packed)) {
 		u8_t PhyBus:3;
 		u8_t DevNum:2;				// index into 1W DevInfo table
-		u8_t Type:1;
+		u8_t Type:2;				// owBUS_? backend
 		u8_t LDF:1;					// Last Device Flag
 		u8_t OD:1;					// 1=OverDrive supported
 		u8_t PSU:1;					// 1=External Power
-		u8_t Spare:7;
+		u8_t Pri:2;					// owPRI_? bus arbitration class
+		u8_t Spare:4;
 	};
 } owdi_t;
 DUMB_STATIC_ASSERT(sizeof(owdi_t) == 12);
@@ -106,6 +110,29 @@ DUMB_STATIC_ASSERT(sizeof(owdi_t) == 12);
 // LD must be same or bigger size as LFD
 // i8LastZero, check
 
+/* 1-Wire master backend, one per bus technology (owdi_t.Type), each operation takes the index of
+ * the master device (owdi_t.DevNum). Optional members may be NULL: blocks fall back to byte loops,
+ * the search triplet to 3 single bit operations, Speed/Level/Yield to a no-op. Search, if present,
+ * replaces the 64 triplets of a search pass after the search command has been written. */
+typedef struct ow_ops_t {
+	int (* Select)(u8_t DevNum, u8_t Bus, u8_t Pri);	// take lock & select bus, 1 = selected
+	int (* Yield)(u8_t DevNum, u8_t Bus, u8_t Pri);		// optional, see ds248xBusYield()
+	void (* Release)(u8_t DevNum);
+	int (* Reset)(u8_t DevNum);							// 1 = presence detected
+	bool (* TouchBit)(u8_t DevNum, bool Bit);
+	u8_t (* WriteByte)(u8_t DevNum, u8_t Byte);
+	u8_t (* ReadByte)(u8_t DevNum);
+	void (* WriteBlock)(u8_t DevNum, u8_t * pBuf, int Len);	// optional
+	void (* ReadBlock)(u8_t DevNum, u8_t * pBuf, int Len);	// optional
+	u8_t (* Triplet)(u8_t DevNum, u8_t Dir);			// optional, returns owTRIP_? bits
+	int (* Search)(u8_t DevNum, u8_t LD, ow_rom_t * psROM, u64_t * pDisc);	// optional, all 64 bits at once
+	int (* Speed)(u8_t DevNum, bool Spd);				// optional
+	int (* Level)(u8_t DevNum, bool Pwr);				// optional
+	u8_t Caps;											// owCAP_? bits
+} ow_ops_t;
+
+extern const ow_ops_t * const owOps[owBUS_NUM];					// indexed by owdi_t.Type (owBUS_?)
+
 // ################################ Generic 1-Wire LINK API's ######################################
 
 int OWReset(owdi_t * psOW) ;
@@ -134,6 +161,7 @@ int OWNext(owdi_t * psOW, bool alarm_only) ;
 int	OWSpeed(owdi_t * psOW, bool speed) ;
 int	OWLevel(owdi_t * psOW, bool level) ;
 u8_t OWCheckCRC(u8_t * buf, u8_t buflen) ;
+u8_t OWCalcCRC8(u8_t * buf, u8_t buflen) ;
 
 int	OWReadROM(owdi_t * psOW) ;
 void OWAddress(owdi_t * psOW, bool Skip) ;